@@ -0,0 +1,56 @@
+#include "AllocationTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+// Global operator new/delete replacement feeding AllocationTracker. Listed in the sources of executables that
+// want accounting, never in a library: a replacement in a static library is silently not linked.
+// USE_ALLOCATION_HOOKS is set for this file by CMake only, builds globbing all sources get an empty unit.
+#ifdef USE_ALLOCATION_HOOKS
+
+void* operator new(std::size_t size)
+{
+	AllocationTracker::onAllocate(size);
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	AllocationTracker::onAllocate(size);
+	return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+#endif
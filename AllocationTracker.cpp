@@ -0,0 +1,148 @@
+#include "AllocationTracker.h"
+#include "Profiler.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _MSC_VER
+#	define ALLOCATION_THREAD_LOCAL __declspec(thread)
+#else
+#	define ALLOCATION_THREAD_LOCAL __thread
+#endif
+
+namespace
+{
+	typedef AllocationTracker T;
+
+	const char* const kSUBSYSTEM_NAMES[T::eSUBSYSTEM_COUNT] = {"other", "decode", "strategy", "encode"};
+
+	//! constant initialized, operator new may run before any constructor
+	std::atomic<unsigned long long> s_counts[T::eSUBSYSTEM_COUNT];
+	std::atomic<unsigned long long> s_bytes[T::eSUBSYSTEM_COUNT];
+	std::atomic<unsigned long long> s_violations;
+	std::atomic<int>                s_policy;
+
+	ALLOCATION_THREAD_LOCAL int  t_subsystem = T::eOTHER;
+	ALLOCATION_THREAD_LOCAL bool t_isNoAlloc = false;
+	ALLOCATION_THREAD_LOCAL bool t_isLogging = false;   //!< stdio may allocate on its own
+
+	//! per-tick statistics, owned by the thread calling endTick()
+	struct TickStatistics
+	{
+		unsigned long long m_lastCounts[T::eSUBSYSTEM_COUNT];
+		unsigned long long m_lastViolations;
+		unsigned           m_ticksWithAllocations[T::eSUBSYSTEM_COUNT];
+		unsigned long long m_maxPerTick[T::eSUBSYSTEM_COUNT];
+		int                m_firstViolationTick;
+		int                m_tickCount;
+
+		TickStatistics() : m_lastCounts(), m_lastViolations(0), m_ticksWithAllocations(), m_maxPerTick(), m_firstViolationTick(-1), m_tickCount(0) {}
+
+		static TickStatistics& get()
+		{
+			static TickStatistics s_statistics;
+			return s_statistics;
+		}
+	};
+}
+
+AllocationTracker::Scope::Scope(Subsystem subsystem, bool isNoAlloc)
+	: m_previous(static_cast<Subsystem>(t_subsystem))
+	, m_wasNoAlloc(t_isNoAlloc)
+{
+	t_subsystem = subsystem;
+	t_isNoAlloc = isNoAlloc;
+}
+
+AllocationTracker::Scope::~Scope()
+{
+	t_subsystem = m_previous;
+	t_isNoAlloc = m_wasNoAlloc;
+}
+
+void AllocationTracker::onAllocate(std::size_t size)
+{
+	s_counts[t_subsystem].fetch_add(1, std::memory_order_relaxed);
+	s_bytes[t_subsystem].fetch_add(size, std::memory_order_relaxed);
+
+	if (!t_isNoAlloc || t_isLogging)
+		return;
+
+	s_violations.fetch_add(1, std::memory_order_relaxed);
+	switch (s_policy.load(std::memory_order_relaxed))
+	{
+	case eLOG:
+		t_isLogging = true;
+		std::fprintf(stderr, "allocation of %u bytes in no-alloc %s scope\n", static_cast<unsigned>(size), kSUBSYSTEM_NAMES[t_subsystem]);
+		t_isLogging = false;
+		break;
+	case eABORT:
+		t_isLogging = true;
+		std::fprintf(stderr, "allocation of %u bytes in no-alloc %s scope, aborting\n", static_cast<unsigned>(size), kSUBSYSTEM_NAMES[t_subsystem]);
+		std::abort();
+	}
+}
+
+unsigned long long AllocationTracker::getCount()
+{
+	unsigned long long count = 0;
+	for (const auto& c: s_counts)
+		count += c.load(std::memory_order_relaxed);
+	return count;
+}
+
+void AllocationTracker::setPolicy(Policy policy)
+{
+	s_policy.store(policy);
+}
+
+void AllocationTracker::endTick(int tick)
+{
+	TickStatistics& s = TickStatistics::get();
+	++s.m_tickCount;
+
+	for (int subsystem = 0; subsystem < eSUBSYSTEM_COUNT; ++subsystem)
+	{
+		const unsigned long long count = s_counts[subsystem].load(std::memory_order_relaxed);
+		const unsigned long long delta = count - s.m_lastCounts[subsystem];
+		s.m_lastCounts[subsystem] = count;
+
+		if (delta)
+			++s.m_ticksWithAllocations[subsystem];
+		if (delta > s.m_maxPerTick[subsystem])
+			s.m_maxPerTick[subsystem] = delta;
+
+#ifdef USE_PROFILER
+		static const char* const kCOUNTER_NAMES[eSUBSYSTEM_COUNT] = {"allocations other", "allocations decode", "allocations strategy", "allocations encode"};
+		static int s_counters[eSUBSYSTEM_COUNT] = {Profiler::registerCounter(kCOUNTER_NAMES[0]), Profiler::registerCounter(kCOUNTER_NAMES[1]),
+			Profiler::registerCounter(kCOUNTER_NAMES[2]), Profiler::registerCounter(kCOUNTER_NAMES[3])};
+		Profiler::count(s_counters[subsystem], delta);
+#endif
+	}
+
+	const unsigned long long violations = s_violations.load(std::memory_order_relaxed);
+	if (violations != s.m_lastViolations && s.m_firstViolationTick < 0)
+		s.m_firstViolationTick = tick;
+	s.m_lastViolations = violations;
+}
+
+bool AllocationTracker::report(const std::string& path)
+{
+	FILE* file = std::fopen(path.c_str(), "w");
+	if (!file)
+		return false;
+
+	const TickStatistics& s = TickStatistics::get();
+	std::fprintf(file, "# %d ticks\n", s.m_tickCount);
+	std::fprintf(file, "subsystem,allocations,bytes,ticks_with_allocations,max_per_tick\n");
+	for (int subsystem = 0; subsystem < eSUBSYSTEM_COUNT; ++subsystem)
+	{
+		std::fprintf(file, "%s,%llu,%llu,%u,%llu\n", kSUBSYSTEM_NAMES[subsystem], s_counts[subsystem].load(), s_bytes[subsystem].load(),
+			s.m_ticksWithAllocations[subsystem], s.m_maxPerTick[subsystem]);
+	}
+	std::fprintf(file, "no-alloc violations,%llu,first tick,%d\n", s_violations.load(), s.m_firstViolationTick);
+
+	std::fclose(file);
+	return true;
+}
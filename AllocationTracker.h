@@ -0,0 +1,69 @@
+#pragma once
+
+#ifndef _ALLOCATION_TRACKER_H_
+#define _ALLOCATION_TRACKER_H_
+
+#include <cstddef>
+#include <string>
+
+//! Heap allocation accounting per subsystem and per tick, fed by the global operator new replacement in
+//! AllocationHooks.cpp. Executables link the hooks explicitly (benchmarks always, the ai with USE_ALLOCATION_TRACKING),
+//! the strategy library never does. Without the hooks every count stays zero.
+//! An allocation inside a no-alloc scope is a violation: counted, and optionally logged to stderr or fatal.
+class AllocationTracker
+{
+public:
+	enum Subsystem
+	{
+		eOTHER = 0,
+		eDECODE,
+		eSTRATEGY,
+		eENCODE,
+		eSUBSYSTEM_COUNT
+	};
+
+	enum Policy
+	{
+		eCOUNT = 0,   //!< violations only show up in the report
+		eLOG,         //!< one stderr line per violation
+		eABORT        //!< std::abort() on the first violation, for tests
+	};
+
+	//! sets subsystem and no-alloc flag of the calling thread until destruction
+	class Scope
+	{
+		Subsystem m_previous;
+		bool      m_wasNoAlloc;
+
+	public:
+		Scope(Subsystem subsystem, bool isNoAlloc);
+		~Scope();
+	};
+
+	//! called by operator new, must not allocate
+	static void onAllocate(std::size_t size);
+
+	//! operator new calls in this process, all threads and subsystems
+	static unsigned long long getCount();
+
+	static void setPolicy(Policy policy);
+
+	//! per-tick bookkeeping, also feeds Profiler counters of the calling thread
+	static void endTick(int tick);
+
+	//! totals per subsystem and no-alloc violations
+	static bool report(const std::string& path);
+};
+
+#ifdef USE_ALLOCATION_TRACKING
+#	define ALLOCATION_CONCAT_(a, b)  a##b
+#	define ALLOCATION_CONCAT(a, b)   ALLOCATION_CONCAT_(a, b)
+#	define ALLOCATION_SCOPE(subsystem, isNoAlloc) \
+		AllocationTracker::Scope ALLOCATION_CONCAT(allocationScope, __LINE__)(AllocationTracker::subsystem, (isNoAlloc))
+#	define ALLOCATION_END_TICK(tick) AllocationTracker::endTick(tick)
+#else
+#	define ALLOCATION_SCOPE(subsystem, isNoAlloc)
+#	define ALLOCATION_END_TICK(tick)
+#endif
+
+#endif
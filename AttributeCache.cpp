@@ -0,0 +1,55 @@
+#include "AttributeCache.h"
+
+using namespace model;
+
+const Attributes AttributeCache::m_default;
+
+AttributeCache::AttributeCache()
+	: m_count(0)
+	, m_tick(-1)
+{
+}
+
+Attributes AttributeCache::compute(const Hockeyist& h, const Game& game)
+{
+	const double zeroFactor = game.getZeroStaminaHockeyistEffectivenessFactor();
+	const double base       = game.getHockeyistAttributeBaseValue();
+
+	Attributes a;
+	a.m_effectiveness = zeroFactor + (1.0 - zeroFactor) * h.getStamina() / game.getHockeyistMaxStamina();
+	a.m_strength      = h.getStrength()  * a.m_effectiveness / base;
+	a.m_endurance     = h.getEndurance() * a.m_effectiveness / base;
+	a.m_dexterity     = h.getDexterity() * a.m_effectiveness / base;
+	a.m_agility       = h.getAgility()   * a.m_effectiveness / base;
+	return a;
+}
+
+void AttributeCache::update(const World& world, const Game& game)
+{
+	if (m_tick == world.getTick())
+		return;
+
+	m_tick  = world.getTick();
+	m_count = 0;
+
+	for (const Hockeyist& h: world.getHockeyists())
+	{
+		if (m_count == kMAX_HOCKEYISTS)
+			break;
+
+		m_ids[m_count]        = h.getId();
+		m_attributes[m_count] = compute(h, game);
+		++m_count;
+	}
+}
+
+const Attributes& AttributeCache::get(TId id) const
+{
+	for (int i = 0; i < m_count; ++i)
+	{
+		if (m_ids[i] == id)
+			return m_attributes[i];
+	}
+
+	return m_default;
+}
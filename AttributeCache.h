@@ -0,0 +1,51 @@
+#pragma once
+
+#ifndef _ATTRIBUTE_CACHE_H_
+#define _ATTRIBUTE_CACHE_H_
+
+#include "model/Game.h"
+#include "model/World.h"
+
+//! Stamina-scaled attribute multipliers (1.0 == base attribute value at full stamina)
+struct Attributes
+{
+	double m_strength;
+	double m_endurance;
+	double m_dexterity;
+	double m_agility;
+	double m_effectiveness;   //!< stamina scaling only
+
+	Attributes() : m_strength(1), m_endurance(1), m_dexterity(1), m_agility(1), m_effectiveness(1) {}
+
+	double getHandling() const { return m_dexterity > m_agility ? m_dexterity : m_agility; }
+};
+
+//! Attribute multipliers of all hockeyists in world, computed once per tick
+class AttributeCache
+{
+public:
+	typedef long long TId;
+	static const int kMAX_HOCKEYISTS = 32;
+
+private:
+	TId        m_ids[kMAX_HOCKEYISTS];
+	Attributes m_attributes[kMAX_HOCKEYISTS];
+	int        m_count;
+	int        m_tick;
+
+	static const Attributes m_default;
+
+public:
+	AttributeCache();
+
+	//! no-op if already done for this tick
+	void update(const model::World& world, const model::Game& game);
+
+	//! default (base) attributes for unknown hockeyist, e.g. a ghost
+	const Attributes& get(TId id) const;
+	const Attributes& get(const model::Hockeyist& h) const { return get(h.getId()); }
+
+	static Attributes compute(const model::Hockeyist& h, const model::Game& game);
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include "BusyPollTransport.h"
+
+#ifdef _LINUX
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
+#include <sys/socket.h>
+
+using namespace std;
+
+namespace {
+    // tight polls before yielding the core between polls, a recv() that finds nothing is ~0.3 us
+    const int TIGHT_SPIN_COUNT = 1000;
+    // kernel side busy poll per recv(), the value Documentation/networking suggests
+    const int SOCKET_BUSY_POLL_MICROSECONDS = 50;
+
+    inline void spinPause() {
+#if defined(__i386__) || defined(__x86_64__)
+        __builtin_ia32_pause();
+#endif
+    }
+}
+
+BusyPollTransport::BusyPollTransport(unique_ptr<Transport> transport, int descriptor, int spinMicroseconds)
+        : transport(std::move(transport)), descriptor(descriptor), spinMicroseconds(spinMicroseconds) {
+    int flags = fcntl(descriptor, F_GETFL, 0);
+    if (flags < 0 || fcntl(descriptor, F_SETFL, flags | O_NONBLOCK) != 0) {
+        exit(10015);
+    }
+
+#ifdef SO_BUSY_POLL
+    // not fatal: unix sockets have no device queue, raising it above net.core.busy_read may need CAP_NET_ADMIN
+    int busyPoll = SOCKET_BUSY_POLL_MICROSECONDS;
+    setsockopt(descriptor, SOL_SOCKET, SO_BUSY_POLL, &busyPoll, sizeof(busyPoll));
+#endif
+}
+
+int BusyPollTransport::receive(void* buffer, int byteCount) {
+    const chrono::steady_clock::time_point deadline = chrono::steady_clock::now() + chrono::microseconds(spinMicroseconds);
+
+    for (int attempt = 0;; ++attempt) {
+        ssize_t receivedByteCount = recv(descriptor, buffer, (size_t) byteCount, 0);
+        if (receivedByteCount >= 0) {
+            return (int) receivedByteCount;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            return -1;
+        }
+
+        if (attempt < TIGHT_SPIN_COUNT) {
+            spinPause();
+        } else if (spinMicroseconds == 0 || chrono::steady_clock::now() < deadline) {
+            sched_yield();
+        } else {
+            // budget spent, the server is slow this tick anyway
+            pollfd readable = {descriptor, POLLIN, 0};
+            poll(&readable, 1, -1);
+        }
+    }
+}
+
+int BusyPollTransport::send(const void* data, int byteCount) {
+    for (;;) {
+        ssize_t sentByteCount = ::send(descriptor, data, (size_t) byteCount, MSG_NOSIGNAL);
+        if (sentByteCount >= 0) {
+            return (int) sentByteCount;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            return -1;
+        }
+
+        // socket buffer full, only happens if the server stops reading
+        pollfd writable = {descriptor, POLLOUT, 0};
+        poll(&writable, 1, -1);
+    }
+}
+
+void BusyPollTransport::interrupt() {
+    shutdown(descriptor, SHUT_RD);
+}
+
+void BusyPollTransport::close() {
+    transport->close();
+}
+
+BusyPollTransport::~BusyPollTransport() {
+    this->close();
+}
+
+#endif
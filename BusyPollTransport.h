@@ -0,0 +1,36 @@
+#pragma once
+
+#ifndef _BUSY_POLL_TRANSPORT_H_
+#define _BUSY_POLL_TRANSPORT_H_
+
+#ifdef _LINUX
+
+#include <memory>
+
+#include "Transport.h"
+
+// Stream socket read by spinning on non-blocking recv() in the calling thread instead of sleeping in the kernel,
+// trading a core for the wake-up latency after the server sends. SO_BUSY_POLL is requested where the kernel has
+// it, so the spin also polls the device queue. Spinning backs off from a tight loop to sched_yield() and, once
+// the spin budget is spent, to a blocking poll(). send() and receive() may be called from different threads.
+class BusyPollTransport : public Transport {
+private:
+    std::unique_ptr<Transport> transport;
+    int descriptor;
+    int spinMicroseconds;
+public:
+    // transport owns the connected descriptor; spinMicroseconds 0 spins without limit.
+    BusyPollTransport(std::unique_ptr<Transport> transport, int descriptor, int spinMicroseconds);
+
+    int receive(void* buffer, int byteCount);
+    int send(const void* data, int byteCount);
+    // Shuts down the reading side of the socket, which also ends a blocking poll().
+    void interrupt();
+    void close();
+
+    ~BusyPollTransport();
+};
+
+#endif
+
+#endif
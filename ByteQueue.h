@@ -0,0 +1,63 @@
+#pragma once
+
+#ifndef _BYTE_QUEUE_H_
+#define _BYTE_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+// Lock-free single producer / single consumer byte ring. The producer writes straight into free space
+// (e.g. recv() into getWritable()), the consumer copies out. Capacity is a power of two.
+class ByteQueue {
+private:
+    std::vector<signed char> buffer;
+    size_t mask;
+
+    // positions only grow, index is position & mask; padded to separate cache lines, C++11 has no aligned new
+    char padding0[64];
+    std::atomic<size_t> head; // next byte to read, written by consumer
+    char padding1[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> tail; // next byte to write, written by producer
+    char padding2[64 - sizeof(std::atomic<size_t>)];
+public:
+    explicit ByteQueue(size_t capacityLog2)
+            : buffer(size_t(1) << capacityLog2), mask((size_t(1) << capacityLog2) - 1), head(0), tail(0) {
+    }
+
+    size_t getCapacity() const { return buffer.size(); }
+
+    // Producer: contiguous free space, may be shorter than all free space at the wrap point.
+    signed char* getWritable(size_t& byteCount) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        const size_t free = buffer.size() - (t - head.load(std::memory_order_acquire));
+        byteCount = std::min(free, buffer.size() - (t & mask));
+        return &buffer[t & mask];
+    }
+
+    // Producer: publishes byteCount bytes written to getWritable().
+    void commit(size_t byteCount) {
+        tail.store(tail.load(std::memory_order_relaxed) + byteCount, std::memory_order_seq_cst);
+    }
+
+    // Consumer: bytes ready to read.
+    size_t getReadable() const {
+        return tail.load(std::memory_order_seq_cst) - head.load(std::memory_order_relaxed);
+    }
+
+    // Consumer: copies up to byteCount bytes out, returns number copied.
+    size_t read(void* data, size_t byteCount) {
+        const size_t h = head.load(std::memory_order_relaxed);
+        const size_t count = std::min(byteCount, tail.load(std::memory_order_acquire) - h);
+        const size_t first = std::min(count, buffer.size() - (h & mask));
+
+        memcpy(data, &buffer[h & mask], first);
+        memcpy((signed char*) data + first, &buffer[0], count - first);
+
+        head.store(h + count, std::memory_order_release);
+        return count;
+    }
+};
+
+#endif
@@ -0,0 +1,184 @@
+#include "DecisionTrace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+	enum ColumnType
+	{
+		eINTEGER = 0,
+		eUNSIGNED,
+		eFLOAT,
+	};
+
+	struct Column
+	{
+		const char*   m_name;
+		unsigned char m_type;
+		unsigned char m_size;
+		size_t        m_offset;
+	};
+
+#define TRACE_COLUMN(name, type, field) { name, type, sizeof(((DecisionTrace::Row*)0)->field), offsetof(DecisionTrace::Row, field) }
+
+	const Column kCOLUMNS[] =
+	{
+		TRACE_COLUMN("tick",         eINTEGER,  m_tick),
+		TRACE_COLUMN("hockeyist",    eINTEGER,  m_hockeyistId),
+		TRACE_COLUMN("behaviour",    eUNSIGNED, m_behaviour),
+		TRACE_COLUMN("replan",       eUNSIGNED, m_replanReason),
+		TRACE_COLUMN("action",       eINTEGER,  m_action),
+		TRACE_COLUMN("candidates",   eUNSIGNED, m_candidates),
+		TRACE_COLUMN("fire_x",       eFLOAT,    m_fireX),
+		TRACE_COLUMN("fire_y",       eFLOAT,    m_fireY),
+		TRACE_COLUMN("intercept_x",  eFLOAT,    m_interceptX),
+		TRACE_COLUMN("intercept_y",  eFLOAT,    m_interceptY),
+		TRACE_COLUMN("move_ns",      eUNSIGNED, m_moveNs),
+		TRACE_COLUMN("puck_owner",   eINTEGER,  m_puckOwnerId),
+		TRACE_COLUMN("scored",       eUNSIGNED, m_isScored),
+		TRACE_COLUMN("conceded",     eUNSIGNED, m_isConceded),
+	};
+
+#undef TRACE_COLUMN
+
+	const unsigned kCOLUMN_COUNT = sizeof(kCOLUMNS) / sizeof(kCOLUMNS[0]);
+	const char     kMAGIC[4]     = {'D', 'T', 'R', 'C'};
+
+	bool writeU32(FILE* file, unsigned value) { return std::fwrite(&value, sizeof(value), 1, file) == 1; }
+	bool readU32(FILE* file, unsigned& value) { return std::fread(&value, sizeof(value), 1, file) == 1; }
+}
+
+const unsigned DecisionTrace::kCAPACITY;
+
+DecisionTrace::DecisionTrace()
+	: m_isStarted(false)
+	, m_rowCount(0)
+{
+}
+
+void DecisionTrace::start()
+{
+	m_rows.assign(kCAPACITY, Row());
+	m_rowCount  = 0;
+	m_isStarted = true;
+}
+
+bool DecisionTrace::isStarted() const
+{
+	return m_isStarted;
+}
+
+DecisionTrace::Row* DecisionTrace::begin(int tick, long long hockeyistId)
+{
+	if (!m_isStarted)
+		return nullptr;
+
+	Row& r = m_rows[m_rowCount++ % kCAPACITY];
+	std::memset(&r, 0, sizeof(r));
+	r.m_tick        = tick;
+	r.m_hockeyistId = hockeyistId;
+	r.m_action      = -1;
+	r.m_fireX       = r.m_fireY      = NAN;
+	r.m_interceptX  = r.m_interceptY = NAN;
+	r.m_puckOwnerId = -1;
+
+	m_rowStart = TClock::now();
+	return &r;
+}
+
+void DecisionTrace::end(Row* row)
+{
+	if (row)
+		row->m_moveNs = static_cast<unsigned>(std::chrono::duration_cast<std::chrono::nanoseconds>(TClock::now() - m_rowStart).count());
+}
+
+bool DecisionTrace::write(const std::string& path) const
+{
+	FILE* file = std::fopen(path.c_str(), "wb");
+	if (!file)
+		return false;
+
+	const unsigned count = static_cast<unsigned>(std::min<unsigned long long>(m_rowCount, kCAPACITY));
+	const unsigned first = static_cast<unsigned>((m_rowCount - count) % kCAPACITY);
+	bool isOk = std::fwrite(kMAGIC, 1, sizeof(kMAGIC), file) == sizeof(kMAGIC)
+		&& writeU32(file, kVERSION) && writeU32(file, count) && writeU32(file, kCOLUMN_COUNT);
+
+	std::vector<unsigned char> values;
+	for (unsigned c = 0; isOk && c < kCOLUMN_COUNT; ++c)
+	{
+		const Column&       column = kCOLUMNS[c];
+		const unsigned char header[] = {static_cast<unsigned char>(std::strlen(column.m_name)), column.m_type, column.m_size};
+
+		values.resize(count * column.m_size);
+		for (unsigned i = 0; i < count; ++i)
+			std::memcpy(&values[i * column.m_size], reinterpret_cast<const unsigned char*>(&m_rows[(first + i) % kCAPACITY]) + column.m_offset, column.m_size);
+
+		isOk = std::fwrite(header, 1, sizeof(header), file) == sizeof(header)
+			&& std::fwrite(column.m_name, 1, header[0], file) == header[0]
+			&& (values.empty() || std::fwrite(&values[0], 1, values.size(), file) == values.size());
+	}
+
+	return std::fclose(file) == 0 && isOk;
+}
+
+bool DecisionTrace::read(const std::string& path, std::vector<Row>& rows)
+{
+	FILE* file = std::fopen(path.c_str(), "rb");
+	if (!file)
+		return false;
+
+	char     magic[4];
+	unsigned version = 0, count = 0, columnCount = 0;
+	bool isOk = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) && std::memcmp(magic, kMAGIC, sizeof(magic)) == 0
+		&& readU32(file, version) && version >= 1 && version <= kVERSION && readU32(file, count) && readU32(file, columnCount);
+
+	if (isOk)
+	{
+		rows.assign(count, Row());
+		for (Row& r: rows)
+		{
+			r.m_action = -1;
+			r.m_fireX  = r.m_fireY      = NAN;
+			r.m_interceptX = r.m_interceptY = NAN;
+			r.m_puckOwnerId = -1;
+		}
+	}
+
+	// unknown columns are skipped, missing ones keep defaults
+	std::vector<unsigned char> values;
+	for (unsigned c = 0; isOk && c < columnCount; ++c)
+	{
+		unsigned char header[3];
+		char          name[256];
+		isOk = std::fread(header, 1, sizeof(header), file) == sizeof(header) && std::fread(name, 1, header[0], file) == header[0];
+		if (!isOk)
+			break;
+
+		name[header[0]] = 0;
+		values.resize(count * header[2]);
+		isOk = values.empty() || std::fread(&values[0], 1, values.size(), file) == values.size();
+
+		for (const Column& column: kCOLUMNS)
+		{
+			if (!isOk || std::strcmp(column.m_name, name) != 0 || column.m_type != header[1] || column.m_size != header[2])
+				continue;
+
+			for (unsigned i = 0; i < count; ++i)
+				std::memcpy(reinterpret_cast<unsigned char*>(&rows[i]) + column.m_offset, &values[i * column.m_size], column.m_size);
+		}
+	}
+
+	std::fclose(file);
+	return isOk;
+}
+
+const char* DecisionTrace::getBehaviourName(int behaviour)
+{
+	static const char* const kNAMES[eBEHAVIOUR_COUNT] = {"none", "attackPuck", "attackNet", "defendTeammate", "defendInitial", "haveRest"};
+	return behaviour >= 0 && behaviour < eBEHAVIOUR_COUNT ? kNAMES[behaviour] : "unknown";
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#ifndef _DECISION_TRACE_H_
+#define _DECISION_TRACE_H_
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+//! Per-match decision trace of one team (see TeamContext): one row per hockeyist per tick, kept in a ring allocated by start()
+//! and written column by column at game end. begin() never allocates, so tracing is allowed inside the strategy's no-alloc scope.
+//! File: "DTRC", version, row count, column count, then for each column its name, type and all values.
+class DecisionTrace
+{
+public:
+	//! strategy behaviour chosen by plan
+	enum Behaviour
+	{
+		eNONE = 0,
+		eATTACK_PUCK,
+		eATTACK_NET,
+		eDEFEND_TEAMMATE,
+		eDEFEND_INITIAL,
+		eHAVE_REST,
+		eBEHAVIOUR_COUNT
+	};
+
+	struct Row
+	{
+		int           m_tick;
+		long long     m_hockeyistId;
+		unsigned char m_behaviour;      //!< Behaviour
+		unsigned char m_replanReason;   //!< Plan::Validity of previous plan, eVALID if kept
+		signed char   m_action;         //!< model::ActionType sent
+		unsigned short m_candidates;    //!< fire or defend positions evaluated, 0 if reused
+		float         m_fireX;          //!< plan target, NaN if none
+		float         m_fireY;
+		float         m_interceptX;     //!< estimated puck position, NaN if not estimated
+		float         m_interceptY;
+		unsigned      m_moveNs;         //!< time spent in MyStrategy::move
+		long long     m_puckOwnerId;    //!< hockeyist owning the puck, -1 if free
+		unsigned char m_isScored;       //!< my team just scored, set until the next faceoff
+		unsigned char m_isConceded;     //!< opponent just scored, set until the next faceoff
+	};
+
+	static const unsigned kVERSION  = 2;          //!< 2: puck owner and goal columns; version 1 files still read
+	static const unsigned kCAPACITY = 8192 * 6;   //!< whole game with overtime for 6 hockeyists, older rows are overwritten
+
+	DecisionTrace();
+
+	void start();
+	bool isStarted() const;
+
+	//! new row for current tick, nullptr when not started; valid until next begin()
+	Row* begin(int tick, long long hockeyistId);
+
+	//! stores time passed since begin()
+	void end(Row* row);
+
+	//! rows kept, oldest first
+	bool write(const std::string& path) const;
+	static bool read(const std::string& path, std::vector<Row>& rows);
+
+	static const char* getBehaviourName(int behaviour);
+
+private:
+	typedef std::chrono::steady_clock TClock;
+
+	bool               m_isStarted;
+	std::vector<Row>   m_rows;       //!< ring of kCAPACITY rows
+	unsigned long long m_rowCount;   //!< rows begun since start()
+	TClock::time_point m_rowStart;
+
+	DecisionTrace(const DecisionTrace&);            //!< denied
+	DecisionTrace& operator=(const DecisionTrace&); //!< denied
+};
+
+#endif
@@ -0,0 +1,115 @@
+#include "EventBus.h"
+#include <cassert>
+
+using namespace model;
+
+EventBus::EventBus()
+	: m_tick(-1)
+	, m_puckOwnerId(-1)
+	, m_puckOwnerPlayerId(-1)
+	, m_isJustScored(false)
+	, m_isJustMissed(false)
+	, m_hockeyistCount(0)
+{
+	for (int& count: m_subscriberCount)
+		count = 0;
+}
+
+void EventBus::subscribe(EventType type, TCallback callback, void* context)
+{
+	int& count = m_subscriberCount[static_cast<int>(type)];
+	assert(count < kMAX_SUBSCRIBERS && "too many subscribers");
+	if (count == kMAX_SUBSCRIBERS)
+		return;
+
+	Subscriber& s = m_subscribers[static_cast<int>(type)][count++];
+	s.m_callback = callback;
+	s.m_context  = context;
+}
+
+void EventBus::dispatch(const Event& e) const
+{
+	const int type = static_cast<int>(e.m_type);
+	for (int i = 0; i < m_subscriberCount[type]; ++i)
+		m_subscribers[type][i].m_callback(m_subscribers[type][i].m_context, e);
+}
+
+const EventBus::HockeyistSnapshot* EventBus::findPrevious(TId id) const
+{
+	for (int i = 0; i < m_hockeyistCount; ++i)
+	{
+		if (m_hockeyists[i].m_id == id)
+			return &m_hockeyists[i];
+	}
+
+	return nullptr;
+}
+
+void EventBus::snapshot(const World& world)
+{
+	const Puck&   puck = world.getPuck();
+	const Player& me   = world.getMyPlayer();
+
+	m_tick              = world.getTick();
+	m_puckOwnerId       = puck.getOwnerHockeyistId();
+	m_puckOwnerPlayerId = puck.getOwnerPlayerId();
+	m_isJustScored      = me.isJustScoredGoal();
+	m_isJustMissed      = me.isJustMissedGoal();
+
+	m_hockeyistCount = 0;
+	for (const Hockeyist& h: world.getHockeyists())
+	{
+		if (m_hockeyistCount == kMAX_HOCKEYISTS)
+			break;
+
+		HockeyistSnapshot& s = m_hockeyists[m_hockeyistCount++];
+		s.m_id       = h.getId();
+		s.m_playerId = h.getPlayerId();
+		s.m_state    = h.getState();
+		s.m_cooldown = h.getRemainingCooldownTicks();
+	}
+}
+
+void EventBus::update(const World& world)
+{
+	if (m_tick == world.getTick())
+		return;
+
+	if (m_tick == -1)
+	{
+		// nothing to compare with yet
+		snapshot(world);
+		return;
+	}
+
+	const int     tick = world.getTick();
+	const Puck&   puck = world.getPuck();
+	const Player& me   = world.getMyPlayer();
+
+	if (puck.getOwnerHockeyistId() != m_puckOwnerId)
+		dispatch(Event(EventType::ePUCK_OWNER_CHANGED, tick, puck.getOwnerHockeyistId(), puck.getOwnerPlayerId(), m_puckOwnerId, m_puckOwnerPlayerId));
+
+	if (me.isJustScoredGoal() && !m_isJustScored)
+		dispatch(Event(EventType::eGOAL_SCORED, tick, -1, me.getId()));
+
+	if (me.isJustMissedGoal() && !m_isJustMissed)
+		dispatch(Event(EventType::eGOAL_MISSED, tick, -1, me.getId()));
+
+	for (const Hockeyist& h: world.getHockeyists())
+	{
+		const HockeyistSnapshot* previous = findPrevious(h.getId());
+		if (!previous)
+			continue;
+
+		if (h.getState() == KNOCKED_DOWN && previous->m_state != KNOCKED_DOWN)
+			dispatch(Event(EventType::eKNOCKED_DOWN, tick, h.getId(), h.getPlayerId()));
+
+		if (h.getRemainingCooldownTicks() == 0 && previous->m_cooldown > 0)
+			dispatch(Event(EventType::eCOOLDOWN_EXPIRED, tick, h.getId(), h.getPlayerId()));
+
+		if ((h.getState() == RESTING) != (previous->m_state == RESTING))
+			dispatch(Event(EventType::eSUBSTITUTED, tick, h.getId(), h.getPlayerId()));
+	}
+
+	snapshot(world);
+}
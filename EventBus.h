@@ -0,0 +1,85 @@
+#pragma once
+
+#ifndef _EVENT_BUS_H_
+#define _EVENT_BUS_H_
+
+#include "model/World.h"
+
+enum class EventType
+{
+	ePUCK_OWNER_CHANGED = 0,
+	eGOAL_SCORED,               //!< by my team
+	eGOAL_MISSED,               //!< my team missed a goal
+	eKNOCKED_DOWN,
+	eCOOLDOWN_EXPIRED,
+	eSUBSTITUTED,               //!< hockeyist went to or came from the bench
+	eCOUNT
+};
+
+struct Event
+{
+	typedef long long TId;
+
+	EventType m_type;
+	int       m_tick;
+	TId       m_hockeyistId;         //!< new puck owner or affected hockeyist, -1 if none
+	TId       m_playerId;            //!< new puck owner player or player of affected hockeyist
+	TId       m_previousHockeyistId; //!< previous puck owner
+	TId       m_previousPlayerId;    //!< previous puck owner player
+
+	Event(EventType type, int tick, TId hockeyist = -1, TId player = -1, TId previousHockeyist = -1, TId previousPlayer = -1)
+		: m_type(type), m_tick(tick), m_hockeyistId(hockeyist), m_playerId(player), m_previousHockeyistId(previousHockeyist), m_previousPlayerId(previousPlayer)
+	{}
+};
+
+//! Detects game state transitions once per tick and dispatches them to subscribers. Subscriptions are plain function + context pairs, no allocations.
+class EventBus
+{
+public:
+	typedef long long TId;
+	typedef void (*TCallback)(void* context, const Event& e);
+
+	static const int kMAX_SUBSCRIBERS = 8;
+	static const int kMAX_HOCKEYISTS  = 32;
+
+private:
+	struct Subscriber
+	{
+		TCallback m_callback;
+		void*     m_context;
+	};
+
+	struct HockeyistSnapshot
+	{
+		TId                   m_id;
+		TId                   m_playerId;
+		model::HockeyistState m_state;
+		int                   m_cooldown;
+	};
+
+	Subscriber        m_subscribers[static_cast<int>(EventType::eCOUNT)][kMAX_SUBSCRIBERS];
+	int               m_subscriberCount[static_cast<int>(EventType::eCOUNT)];
+
+	int               m_tick;
+	TId               m_puckOwnerId;
+	TId               m_puckOwnerPlayerId;
+	bool              m_isJustScored;
+	bool              m_isJustMissed;
+	HockeyistSnapshot m_hockeyists[kMAX_HOCKEYISTS];
+	int               m_hockeyistCount;
+
+	const HockeyistSnapshot* findPrevious(TId id) const;
+	void snapshot(const model::World& world);
+
+public:
+	EventBus();
+
+	void subscribe(EventType type, TCallback callback, void* context = nullptr);
+
+	void dispatch(const Event& e) const;
+
+	//! compare world with previous tick and dispatch transitions. No-op if already done for this tick.
+	void update(const model::World& world);
+};
+
+#endif
@@ -0,0 +1,266 @@
+#include "LocalTransport.h"
+
+#ifdef _LINUX
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    const uint32_t SHM_MAGIC = 0x43484D53; // "SMHC"
+
+    // how long a waiting side sleeps before checking that the peer process still exists
+    const long LIVENESS_PERIOD_NANOSECONDS = 100 * 1000 * 1000;
+    // both sides wait this long for the other one to show up
+    const int ATTACH_ATTEMPT_COUNT = 50;
+    const chrono::milliseconds ATTACH_ATTEMPT_PERIOD(100);
+
+    // shared, not FUTEX_PRIVATE_FLAG: the word is mapped by two processes
+    void waitFutex(std::atomic<int>& word, int expected, long timeoutNanoseconds) {
+        timespec timeout = {timeoutNanoseconds / 1000000000, timeoutNanoseconds % 1000000000};
+        syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT, expected, &timeout, NULL, 0);
+    }
+
+    void wakeFutex(std::atomic<int>& word) {
+        syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+
+    void ring(std::atomic<int>& bell, std::atomic<int>& isWaiting) {
+        // seq_cst pairs with the waiter setting its flag before re-checking, no wake-up is lost
+        if (isWaiting.load()) {
+            bell.fetch_add(1);
+            wakeFutex(bell);
+        }
+    }
+
+    bool isProcessAlive(pid_t pid) {
+        // EPERM: exists, owned by somebody else
+        return kill(pid, 0) == 0 || errno == EPERM;
+    }
+
+    // false if the peer process is gone while still not ready
+    template <typename Predicate>
+    bool waitFor(std::atomic<int>& bell, std::atomic<int>& isWaiting, pid_t peerPid, Predicate isReady) {
+        while (!isReady()) {
+            int ticket = bell.load();
+            isWaiting.store(1);
+            if (!isReady()) {
+                waitFutex(bell, ticket, LIVENESS_PERIOD_NANOSECONDS);
+            }
+            isWaiting.store(0);
+
+            if (!isReady() && !isProcessAlive(peerPid)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+DescriptorTransport::DescriptorTransport(int descriptor)
+        : descriptor(descriptor) {
+}
+
+int DescriptorTransport::receive(void* buffer, int byteCount) {
+    ssize_t receivedByteCount;
+    do {
+        receivedByteCount = recv(descriptor, buffer, (size_t) byteCount, 0);
+    } while (receivedByteCount < 0 && errno == EINTR);
+    return (int) receivedByteCount;
+}
+
+int DescriptorTransport::send(const void* data, int byteCount) {
+    ssize_t sentByteCount;
+    do {
+        sentByteCount = ::send(descriptor, data, (size_t) byteCount, MSG_NOSIGNAL);
+    } while (sentByteCount < 0 && errno == EINTR);
+    return (int) sentByteCount;
+}
+
+void DescriptorTransport::interrupt() {
+    if (descriptor >= 0) {
+        shutdown(descriptor, SHUT_RD);
+    }
+}
+
+void DescriptorTransport::close() {
+    if (descriptor >= 0) {
+        ::close(descriptor);
+        descriptor = -1;
+    }
+}
+
+DescriptorTransport::~DescriptorTransport() {
+    this->close();
+}
+
+namespace {
+    int connectUnixSocket(const string& path) {
+        sockaddr_un address = sockaddr_un();
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path)) {
+            exit(10001);
+        }
+        strcpy(address.sun_path, path.c_str());
+
+        int descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (descriptor < 0 || connect(descriptor, (sockaddr*) &address, sizeof(address)) != 0) {
+            exit(10001);
+        }
+        return descriptor;
+    }
+}
+
+UnixSocketTransport::UnixSocketTransport(const string& path)
+        : DescriptorTransport(connectUnixSocket(path)) {
+}
+
+ShmTransport::ShmTransport(const string& name, bool isServer)
+        : name(name[0] == '/' ? name : "/" + name), isServer(isServer), region(NULL), input(NULL), output(NULL), peerPid(0) {
+    int descriptor = -1;
+    if (isServer) {
+        shm_unlink(this->name.c_str());
+        descriptor = shm_open(this->name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (descriptor >= 0 && ftruncate(descriptor, sizeof(Region)) != 0) {
+            exit(10001);
+        }
+    } else {
+        // the server may still be starting
+        for (int attempt = 0; attempt < ATTACH_ATTEMPT_COUNT && descriptor < 0; ++attempt) {
+            descriptor = shm_open(this->name.c_str(), O_RDWR, 0);
+            if (descriptor < 0) {
+                this_thread::sleep_for(ATTACH_ATTEMPT_PERIOD);
+            }
+        }
+    }
+    if (descriptor < 0) {
+        exit(10001);
+    }
+
+    void* memory = mmap(NULL, sizeof(Region), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if (memory == MAP_FAILED) {
+        exit(10001);
+    }
+
+    // a fresh region is zero filled, which is an empty open ring
+    region = static_cast<Region*>(memory);
+    input = isServer ? &region->toServer : &region->toClient;
+    output = isServer ? &region->toClient : &region->toServer;
+
+    if (isServer) {
+        region->serverPid.store(getpid());
+        region->magic.store(SHM_MAGIC);
+        for (int attempt = 0; attempt < ATTACH_ATTEMPT_COUNT && !region->isClientAttached.load(); ++attempt) {
+            waitFutex(region->isClientAttached, 0, chrono::duration_cast<chrono::nanoseconds>(ATTACH_ATTEMPT_PERIOD).count());
+        }
+        if (!region->isClientAttached.load()) {
+            shm_unlink(this->name.c_str());
+            exit(10001);
+        }
+        peerPid = region->clientPid.load();
+    } else {
+        for (int attempt = 0; attempt < ATTACH_ATTEMPT_COUNT && region->magic.load() != SHM_MAGIC; ++attempt) {
+            this_thread::sleep_for(ATTACH_ATTEMPT_PERIOD);
+        }
+        if (region->magic.load() != SHM_MAGIC) {
+            exit(10001);
+        }
+        peerPid = region->serverPid.load();
+        region->clientPid.store(getpid());
+        region->isClientAttached.store(1);
+        wakeFutex(region->isClientAttached);
+    }
+}
+
+int ShmTransport::receive(void* buffer, int byteCount) {
+    Ring& r = *input;
+    if (!waitFor(r.dataBell, r.isReaderWaiting, peerPid, [&r]() { return r.tail.load() != r.head.load(std::memory_order_relaxed) || r.isClosed.load(); })) {
+        return 0;
+    }
+
+    const uint32_t head = r.head.load(std::memory_order_relaxed);
+    const uint32_t count = min((uint32_t) byteCount, r.tail.load(std::memory_order_acquire) - head);
+    const uint32_t offset = head % RING_CAPACITY;
+    const uint32_t first = min(count, RING_CAPACITY - offset);
+    memcpy(buffer, r.data + offset, first);
+    memcpy((char*) buffer + first, r.data, count - first);
+
+    r.head.store(head + count);
+    ring(r.spaceBell, r.isWriterWaiting);
+    return (int) count;
+}
+
+int ShmTransport::send(const void* data, int byteCount) {
+    Ring& r = *output;
+    if (!waitFor(r.spaceBell, r.isWriterWaiting, peerPid, [&r]() { return r.tail.load(std::memory_order_relaxed) - r.head.load() < RING_CAPACITY || r.isClosed.load(); })
+            || r.isClosed.load()) {
+        return -1;
+    }
+
+    const uint32_t tail = r.tail.load(std::memory_order_relaxed);
+    const uint32_t count = min((uint32_t) byteCount, RING_CAPACITY - (tail - r.head.load(std::memory_order_acquire)));
+    const uint32_t offset = tail % RING_CAPACITY;
+    const uint32_t first = min(count, RING_CAPACITY - offset);
+    memcpy(r.data + offset, data, first);
+    memcpy(r.data, (const char*) data + first, count - first);
+
+    r.tail.store(tail + count);
+    ring(r.dataBell, r.isReaderWaiting);
+    return (int) count;
+}
+
+void ShmTransport::interrupt() {
+    if (region == NULL) {
+        return;
+    }
+
+    // input only, the server keeps reading our moves
+    input->isClosed.store(1);
+    input->dataBell.fetch_add(1);
+    wakeFutex(input->dataBell);
+}
+
+void ShmTransport::close() {
+    if (region == NULL) {
+        return;
+    }
+
+    // both directions and both doorbells: a receive() or a send() blocked here or in the peer gives up;
+    // the mapping lives until destruction
+    Ring* rings[] = {output, input};
+    for (Ring* r: rings) {
+        r->isClosed.store(1);
+        r->dataBell.fetch_add(1);
+        wakeFutex(r->dataBell);
+        r->spaceBell.fetch_add(1);
+        wakeFutex(r->spaceBell);
+    }
+
+    if (isServer) {
+        shm_unlink(name.c_str());
+    }
+}
+
+ShmTransport::~ShmTransport() {
+    this->close();
+    if (region != NULL) {
+        munmap(region, sizeof(Region));
+    }
+}
+
+#endif
@@ -0,0 +1,91 @@
+#pragma once
+
+#ifndef _LOCAL_TRANSPORT_H_
+#define _LOCAL_TRANSPORT_H_
+
+#ifdef _LINUX
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+#include "Transport.h"
+
+// Connected blocking stream socket. send() and receive() may be called from different threads.
+class DescriptorTransport : public Transport {
+private:
+    int descriptor;
+public:
+    explicit DescriptorTransport(int descriptor);
+
+    int receive(void* buffer, int byteCount);
+    int send(const void* data, int byteCount);
+    void interrupt();
+    void close();
+
+    int getDescriptor() const { return descriptor; }
+
+    ~DescriptorTransport();
+};
+
+// AF_UNIX stream socket to a runner on the same host: no TCP/IP stack, no Nagle, no checksums.
+class UnixSocketTransport : public DescriptorTransport {
+public:
+    // Exits like SocketTransport if the socket can't be connected.
+    explicit UnixSocketTransport(const std::string& path);
+};
+
+// Two byte rings in POSIX shared memory, one per direction, with futex doorbells: a waiting reader sleeps in
+// the kernel until the writer rings, no syscall at all while both sides keep up. The server side creates
+// the region, the client side attaches to it. send() and receive() may be called from different threads.
+// A waiting side wakes up now and then to check that the peer process still exists, so a peer killed without
+// close() ends the stream instead of blocking forever.
+class ShmTransport : public Transport {
+public:
+    static const uint32_t RING_CAPACITY = 1 << 20;
+
+    struct Ring {
+        std::atomic<uint32_t> head; // read position, written by reader
+        char padding0[64 - sizeof(std::atomic<uint32_t>)];
+        std::atomic<uint32_t> tail; // write position, written by writer
+        char padding1[64 - sizeof(std::atomic<uint32_t>)];
+        std::atomic<int> dataBell; // futex: bumped by writer when reader is waiting
+        std::atomic<int> spaceBell; // futex: bumped by reader when writer is waiting
+        std::atomic<int> isReaderWaiting;
+        std::atomic<int> isWriterWaiting;
+        std::atomic<int> isClosed; // either side closed, or the reader was interrupted; ends waits at both ends
+        char data[RING_CAPACITY];
+    };
+
+    struct Region {
+        std::atomic<uint32_t> magic;
+        std::atomic<int> isClientAttached;
+        std::atomic<int> serverPid;
+        std::atomic<int> clientPid;
+        Ring toClient;
+        Ring toServer;
+    };
+private:
+    std::string name;
+    bool isServer;
+    Region* region;
+    Ring* input;
+    Ring* output;
+    pid_t peerPid;
+public:
+    // Server: creates the region (replacing a stale one) and waits up to a few seconds for the client to attach.
+    // Client: waits up to a few seconds for the region to appear. Exits like SocketTransport on failure.
+    ShmTransport(const std::string& name, bool isServer);
+
+    int receive(void* buffer, int byteCount);
+    int send(const void* data, int byteCount);
+    void interrupt();
+    void close();
+
+    ~ShmTransport();
+};
+
+#endif
+
+#endif
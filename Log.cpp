@@ -0,0 +1,209 @@
+#include "Log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#ifdef _MSC_VER
+#	define LOG_THREAD_LOCAL __declspec(thread)
+#else
+#	define LOG_THREAD_LOCAL __thread
+#endif
+
+namespace
+{
+	typedef std::chrono::steady_clock TClock;
+
+	//! single producer (the thread that claimed it), single consumer (writer thread)
+	struct ThreadRing
+	{
+		std::vector<Log::Record> m_records;
+		std::atomic<unsigned>    m_head;      //!< next record to write, owned by producer
+		std::atomic<unsigned>    m_tail;      //!< next record to format, owned by writer
+
+		ThreadRing() : m_head(0), m_tail(0) {}
+	};
+
+	struct LogState
+	{
+		ThreadRing               m_rings[Log::kMAX_THREADS];
+		std::atomic<int>         m_ringCount;   //!< rings claimed by threads, may exceed kMAX_THREADS
+		std::atomic<bool>        m_isStarted;
+		std::atomic<bool>        m_isStopping;
+		std::atomic<unsigned>    m_dropped;
+		std::atomic<int>         m_tick;
+		TClock::time_point       m_startTime;
+		FILE*                    m_file;
+		std::thread              m_writer;
+
+		LogState() : m_ringCount(0), m_isStarted(false), m_isStopping(false), m_dropped(0), m_tick(-1), m_file(nullptr) {}
+
+		static LogState& get()
+		{
+			static LogState s_state;
+			return s_state;
+		}
+	};
+
+	//! ring of the calling thread, claimed on its first record; stays claimed across stop() and start()
+	LOG_THREAD_LOCAL ThreadRing* t_ring = nullptr;
+
+	void formatArg(FILE* file, const Log::Arg& a)
+	{
+		switch (a.m_type)
+		{
+		case Log::Arg::eINT:     std::fprintf(file, "%lld", a.m_int);                      break;
+		case Log::Arg::eUINT:    std::fprintf(file, "%llu", a.m_uint);                     break;
+		case Log::Arg::eDOUBLE:  std::fprintf(file, "%g", a.m_double);                     break;
+		case Log::Arg::eBOOL:    std::fputs(a.m_bool ? "true" : "false", file);            break;
+		case Log::Arg::eLITERAL: std::fputs(a.m_literal ? a.m_literal : "(null)", file);   break;
+		}
+	}
+
+	void formatRecord(FILE* file, const Log::Record& r)
+	{
+		std::fprintf(file, "%lld.%06lld [%d] ", r.m_time / 1000000, r.m_time % 1000000, r.m_tick);
+
+		int arg = 0;
+		for (const char* c = r.m_format; *c; ++c)
+		{
+			if (c[0] == '{' && c[1] == '}' && arg < r.m_argCount)
+			{
+				formatArg(file, r.m_args[arg++]);
+				++c;
+			}
+			else
+			{
+				std::fputc(*c, file);
+			}
+		}
+		std::fputc('\n', file);
+	}
+
+	//! drains rings one after another, sleeps when idle so the writing threads never have to signal
+	void writerLoop()
+	{
+		LogState& s = LogState::get();
+		for (;;)
+		{
+			const bool isStopping = s.m_isStopping.load(std::memory_order_acquire);
+			const int  ringCount  = std::min(s.m_ringCount.load(std::memory_order_acquire), static_cast<int>(Log::kMAX_THREADS));
+
+			for (int i = 0; i < ringCount; ++i)
+			{
+				ThreadRing&    ring = s.m_rings[i];
+				const unsigned head = ring.m_head.load(std::memory_order_acquire);
+				unsigned       tail = ring.m_tail.load(std::memory_order_relaxed);
+
+				for (; tail != head; ++tail)
+				{
+					formatRecord(s.m_file, ring.m_records[tail % Log::kCAPACITY]);
+					ring.m_tail.store(tail + 1, std::memory_order_release);
+				}
+			}
+
+			if (isStopping)
+				break;
+
+			std::fflush(s.m_file);
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+
+		const unsigned dropped = s.m_dropped.load();
+		if (dropped)
+			std::fprintf(s.m_file, "log: %u records dropped\n", dropped);
+		std::fflush(s.m_file);
+	}
+}
+
+bool Log::start(const std::string& path)
+{
+	LogState& s = LogState::get();
+	if (s.m_isStarted)
+		return false;
+
+	s.m_file = path.empty() ? stderr : std::fopen(path.c_str(), "w");
+	if (!s.m_file)
+		return false;
+
+	// writing threads never allocate
+	for (ThreadRing& ring: s.m_rings)
+		ring.m_records.resize(kCAPACITY);
+
+	s.m_startTime  = TClock::now();
+	s.m_isStopping = false;
+	s.m_writer     = std::thread(writerLoop);
+	s.m_isStarted.store(true, std::memory_order_release);
+	return true;
+}
+
+void Log::stop()
+{
+	LogState& s = LogState::get();
+	if (!s.m_isStarted)
+		return;
+
+	s.m_isStarted  = false;
+	s.m_isStopping.store(true, std::memory_order_release);
+	s.m_writer.join();
+
+	if (s.m_file != stderr)
+		std::fclose(s.m_file);
+	s.m_file = nullptr;
+}
+
+bool Log::isStarted()
+{
+	return LogState::get().m_isStarted.load(std::memory_order_relaxed);
+}
+
+void Log::setTick(int tick)
+{
+	LogState::get().m_tick.store(tick, std::memory_order_relaxed);
+}
+
+unsigned Log::getDroppedCount()
+{
+	return LogState::get().m_dropped.load();
+}
+
+Log::Record* Log::acquire()
+{
+	LogState& s = LogState::get();
+	if (!s.m_isStarted.load(std::memory_order_acquire))
+		return nullptr;
+
+	if (!t_ring)
+	{
+		const int index = s.m_ringCount.load(std::memory_order_relaxed) < kMAX_THREADS ? s.m_ringCount.fetch_add(1, std::memory_order_acq_rel) : kMAX_THREADS;
+		if (index >= kMAX_THREADS)
+		{
+			s.m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		t_ring = &s.m_rings[index];
+	}
+
+	ThreadRing&    ring = *t_ring;
+	const unsigned head = ring.m_head.load(std::memory_order_relaxed);
+	if (head - ring.m_tail.load(std::memory_order_acquire) >= static_cast<unsigned>(kCAPACITY))
+	{
+		s.m_dropped.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Record& r = ring.m_records[head % kCAPACITY];
+	r.m_time = std::chrono::duration_cast<std::chrono::microseconds>(TClock::now() - s.m_startTime).count();
+	r.m_tick = s.m_tick.load(std::memory_order_relaxed);
+	return &r;
+}
+
+void Log::commit()
+{
+	ThreadRing& ring = *t_ring;
+	ring.m_head.store(ring.m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
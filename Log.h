@@ -0,0 +1,90 @@
+#pragma once
+
+#ifndef _LOG_H_
+#define _LOG_H_
+
+#include <string>
+#include <type_traits>
+
+//! Asynchronous log. Each writing thread copies format pointer and raw arguments into its own ring, preallocated by start(),
+//! background thread formats records and writes them to file. Full ring or too many threads drop records, never block.
+//! Format must be a literal, each "{}" is replaced by next argument; strings must be literals too.
+class Log
+{
+public:
+	static const int kMAX_ARGS = 8;
+	static const int kCAPACITY    = 4096;   //!< records per thread, power of two
+	static const int kMAX_THREADS = 4;      //!< tick, receive-ahead and pipeline threads, one spare
+
+	struct Arg
+	{
+		enum Type { eINT, eUINT, eDOUBLE, eBOOL, eLITERAL };
+
+		Type m_type;
+		union
+		{
+			long long          m_int;
+			unsigned long long m_uint;
+			double             m_double;
+			bool               m_bool;
+			const char*        m_literal;
+		};
+	};
+
+	struct Record
+	{
+		long long   m_time;      //!< microseconds since start()
+		int         m_tick;
+		const char* m_format;
+		int         m_argCount;
+		Arg         m_args[kMAX_ARGS];
+	};
+
+	//! opens file and starts writer thread, empty path means stderr
+	static bool start(const std::string& path);
+
+	//! writes pending records and joins writer thread
+	static void stop();
+
+	static bool     isStarted();
+	static void     setTick(int tick);
+	static unsigned getDroppedCount();
+
+	template <typename... Args>
+	static void write(const char* format, const Args&... args)
+	{
+		static_assert(sizeof...(Args) <= kMAX_ARGS, "too many log arguments");
+
+		Record* r = acquire();
+		if (!r)
+			return;
+
+		const Arg packed[] = {makeArg(args)..., makeArg(false)};
+		for (int i = 0; i < static_cast<int>(sizeof...(Args)); ++i)
+			r->m_args[i] = packed[i];
+
+		r->m_format   = format;
+		r->m_argCount = sizeof...(Args);
+		commit();
+	}
+
+private:
+	static Record* acquire();
+	static void    commit();
+
+	static Arg makeArg(long long v)           { Arg a; a.m_type = Arg::eINT;     a.m_int     = v; return a; }
+	static Arg makeArg(unsigned long long v)  { Arg a; a.m_type = Arg::eUINT;    a.m_uint    = v; return a; }
+	static Arg makeArg(int v)                 { return makeArg(static_cast<long long>(v)); }
+	static Arg makeArg(long v)                { return makeArg(static_cast<long long>(v)); }
+	static Arg makeArg(unsigned v)            { return makeArg(static_cast<unsigned long long>(v)); }
+	static Arg makeArg(unsigned long v)       { return makeArg(static_cast<unsigned long long>(v)); }
+	static Arg makeArg(double v)              { Arg a; a.m_type = Arg::eDOUBLE;  a.m_double  = v; return a; }
+	static Arg makeArg(float v)               { return makeArg(static_cast<double>(v)); }
+	static Arg makeArg(bool v)                { Arg a; a.m_type = Arg::eBOOL;    a.m_bool    = v; return a; }
+	static Arg makeArg(const char* v)         { Arg a; a.m_type = Arg::eLITERAL; a.m_literal = v; return a; }
+
+	template <typename T>
+	static typename std::enable_if<std::is_enum<T>::value, Arg>::type makeArg(T v) { return makeArg(static_cast<long long>(v)); }
+};
+
+#endif
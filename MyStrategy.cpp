@@ -1,44 +1,106 @@
 #include "MyStrategy.h"
 #include "Statistics.h"
+#include "PathPlanner.h"
+#include "StealModel.h"
+#include "AttributeCache.h"
+#include "Plan.h"
+#include "EventBus.h"
+#include "TeamContext.h"
+#include "Parameters.h"
+#include "Physics.h"
+#include "Profiler.h"
+#include "DecisionTrace.h"
 #define _USE_MATH_DEFINES
 
 #include <cmath>
 #include <cassert>
 #include <cstdlib>
 #include <algorithm>
-#include <set>
 
-#ifdef USE_LOG
-#include <windows.h>
-#undef min
-#undef max
-#endif
 
 using namespace model;
 
 const double MyStrategy::STRIKE_ANGLE        = PI / 180.0;
-long long    MyStrategy::m_initialDefenderId = -1;
-std::map<MyStrategy::TId, PreferredFire> MyStrategy::m_firePositionMap;
 
 void MyStrategy::move(const Hockeyist& self, const World& world, const Game& game, Move& move) 
 {
+	PROFILE_SCOPE("MyStrategy::move");
+	m_trace = m_decisionTrace.begin(world.getTick(), self.getId());
+	m_scratch.reset();
+
 	// update service pointers and statistics
 	update(&self, &world, &game, &move);
 	updateStatistics();
+	m_events.update(world);
+	m_attributes.update(world, game);
 	
+	// keep previous decision while it's still valid
+	Plan& plan = m_plans[self.getId()];
+	const Plan::Validity validity = plan.check(self, world, getSituation());
+	if (validity != Plan::eVALID)
+	{
+		TActionPtr action = getCurrentAction();
+		plan.start(action, getSituation(), world.getTick(), m_parameters.getInt(Parameters::ePLAN_LIFETIME));
+	}
+
 	// perform actions
-	TActionPtr action = getCurrentAction();
-	(this->*action)();
+	m_plan = &plan;
+	(this->*plan.getAction())();
+
+	if (m_trace)
+	{
+		m_trace->m_behaviour    = static_cast<unsigned char>(getBehaviour(plan.getAction()));
+		m_trace->m_replanReason = static_cast<unsigned char>(validity);
+		m_trace->m_action       = static_cast<signed char>(move.getAction());
+		m_trace->m_puckOwnerId  = world.getPuck().getOwnerHockeyistId();
+		m_trace->m_isScored     = world.getMyPlayer().isJustScoredGoal() ? 1 : 0;
+		m_trace->m_isConceded   = world.getMyPlayer().isJustMissedGoal() ? 1 : 0;
+		if (plan.hasTarget())
+		{
+			m_trace->m_fireX = static_cast<float>(plan.getTarget().x);
+			m_trace->m_fireY = static_cast<float>(plan.getTarget().y);
+		}
+		m_decisionTrace.end(m_trace);
+		m_trace = nullptr;
+	}
 
+	m_plan = nullptr;
 	update(nullptr, nullptr, nullptr, nullptr);
 }
 
-MyStrategy::MyStrategy() 
+MyStrategy::MyStrategy(TeamContext& team, int teamSize) 
 	: m_self(nullptr)
 	, m_world(nullptr)
 	, m_game(nullptr)
 	, m_move(nullptr)
+	, m_plan(nullptr)
+	, m_trace(nullptr)
+	, m_team(team)
+	, m_parameters(team.m_parameters)
+	, m_initialDefenderId(team.m_initialDefenderId)
+	, m_firePositionMap(team.m_firePositionMap)
+	, m_pathPlanner(team.m_pathPlanner)
+	, m_stealModel(team.m_stealModel)
+	, m_attributes(team.m_attributes)
+	, m_plans(team.m_plans)
+	, m_events(team.m_events)
+	, m_scratch(team.m_scratch)
+	, m_decisionTrace(team.m_decisionTrace)
 { 
+	switch (teamSize)
+	{
+	case 2:  specialize<2>(); break;
+	case 3:  specialize<3>(); break;
+	case 6:  specialize<6>(); break;
+	default: specialize<kANY_TEAM_SIZE>(); break;
+	}
+}
+
+template <int TeamSize>
+void MyStrategy::specialize()
+{
+	m_firePoints[0] = &MyStrategy::getFirePoint<TeamSize, false>;
+	m_firePoints[1] = &MyStrategy::getFirePoint<TeamSize, true>;
 }
 
 MyStrategy::~MyStrategy()
@@ -50,61 +112,30 @@ MyStrategy::~MyStrategy()
 void MyStrategy::attackPuck()
 {
 	const Point puckPos = getEstimatedPuckPos();
+	if (m_trace)
+	{
+		m_trace->m_interceptX = static_cast<float>(puckPos.x);
+		m_trace->m_interceptY = static_cast<float>(puckPos.y);
+	}
 
 	m_move->setSpeedUp(1.0);
 	m_move->setTurn(m_self->getAngleTo(puckPos.x, puckPos.y));
 	m_move->setAction(m_self->getState() == SWINGING ? CANCEL_STRIKE : TAKE_PUCK);
 	
 	improveManeuverability(); // TODO - check me!
-	
-	// if can't get reach puck, but can reach opponent - feel free to punch him if there is no teammate in between
-	// TODO - check this
-	const Puck&      puck       = m_world->getPuck();
-	const TId        ownerId    = puck.getOwnerHockeyistId(); 
-	const Hockeyist* puckOwner  = find_unit(getHockeyists(), [ownerId](const Hockeyist& h){return !h.isTeammate() && h.getId() == ownerId;});
-	if (!puckOwner)
-		return;
-	
-	const TId        attackerId = m_self->getId();
-	const Hockeyist* attacker   = m_self;
-	const Hockeyist* teammateBetween = find_unit(getHockeyists(), [attacker, puckOwner, this/*bug*/](const Hockeyist& h) 
-	{
-		return h.isTeammate() && MyStrategy::isInBetween(Point(attacker->getX(), attacker->getY()), h, *puckOwner, attacker->getRadius());
-	});
-	const Hockeyist* enemyBetween = find_unit(getHockeyists(), [attacker, puckOwner, this/*bug*/](const Hockeyist& h) 
-	{
-		return !h.isTeammate() && MyStrategy::isInBetween(Point(attacker->getX(), attacker->getY()), h, *puckOwner, attacker->getRadius());
-	});
-	
-	if (enemyBetween != nullptr)
-		teammateBetween = nullptr; // don't miss a chance to hit two enemies
-	
-	static std::set<TId> swingingOnEnemySet;
-	if ( !teammateBetween && m_self->getDistanceTo(puck) > m_game->getStickLength() && m_self->getDistanceTo(*puckOwner) < m_game->getStickLength()
-	  && std::abs(m_self->getAngleTo(*puckOwner)) < m_game->getStickSector() / 2)
-	{
-		if (swingingOnEnemySet.find(attackerId) != swingingOnEnemySet.end() || puckOwner->getState() == SWINGING)
-		{
-			swingingOnEnemySet.erase(attackerId);
-			m_move->setAction(STRIKE);
-		}			
-		else
-		{
-			swingingOnEnemySet.insert(attackerId);
-			m_move->setAction(SWING);
-		}
-	}
-	else
-	{
-		swingingOnEnemySet.erase(attackerId);
-	}
+
+	// try to get puck from opponent: take it away or knock its owner down, coordinated with teammates
+	m_stealModel.evaluate(*m_world, *m_game, m_attributes);
+	const StealModel::Decision& decision = m_stealModel.getDecision(m_self->getTeammateIndex());
+	if (decision.m_action != NONE)
+		m_move->setAction(decision.m_action);
 }
 
 void MyStrategy::defendInitial()
 {
 	// look for defend point between attacker ghost and net corner,
 	const Hockeyist* attacker = getPuckOwner();
-	const Hockeyist* defender = find_unit(getHockeyists(), [](const Hockeyist& h){ return h.getId() == m_initialDefenderId;});
+	const Hockeyist* defender = find_unit(getHockeyists(), [this](const Hockeyist& h){ return h.getId() == m_initialDefenderId;});
 
 	if (!attacker)
 	{
@@ -116,6 +147,8 @@ void MyStrategy::defendInitial()
 	assert(attacker && !attacker->isTeammate() && defender && defender->isTeammate());
 
 	TFirePositions positions = fillDefenderPositions(attacker, defender);
+	if (m_trace)
+		m_trace->m_candidates = static_cast<unsigned short>(positions.size());
 	bool isAlreadyDefending = std::find_if(positions.begin(), positions.end(), 
 		[defender](const FirePosition& p) {return defender->getDistanceTo(p.m_pos.x, p.m_pos.y) < defender->getRadius();} ) != positions.end();
 
@@ -125,12 +158,12 @@ void MyStrategy::defendInitial()
 		const Puck& puck = m_world->getPuck();
 		m_move->setTurn(defender->getAngleTo(puck));
 
-		static const double kSpeedupArea  = m_game->getStickLength();
-		static const double kSlowdownArea = std::min(defender->getRadius()*2, kSpeedupArea / 2);
+		const double kSpeedupArea  = m_game->getStickLength();
+		const double kSlowdownArea = std::min(defender->getRadius()*2, kSpeedupArea / 2);
 		double distanceToPuck = defender->getDistanceTo(puck);
 
 		if (distanceToPuck > kSpeedupArea)
-			m_move->setSpeedUp(0.5);
+			m_move->setSpeedUp(m_parameters[Parameters::eDEFEND_SPEED_UP]);
 		else if (distanceToPuck < kSlowdownArea)
 			m_move->setSpeedUp(-1.0);
 		else
@@ -145,7 +178,7 @@ void MyStrategy::defendInitial()
 		Point pos = positions.empty() ? Point(defender->getX(), defender->getY()) : positions.front().m_pos;
 
 		double angleTo = defender->getAngleTo(pos.x, pos.y);
-		bool shouldGoBack = (Statistics::instance()->getMySide() == Statistics::eLEFT_SIDE) ? pos.x < defender->getX() : pos.x > defender->getRadius();
+		bool shouldGoBack = (getStatistics()->getMySide() == Statistics::eLEFT_SIDE) ? pos.x < defender->getX() : pos.x > defender->getRadius();
 		if(shouldGoBack)
 		{
 			m_move->setSpeedUp(-1.0);  // go straight backward
@@ -168,15 +201,13 @@ void MyStrategy::attackNet()
 		if(m_self->getRemainingCooldownTicks() == 0)
 		{
 			m_move->setAction(ActionType::STRIKE);
-			Statistics::instance()->getPlayer().attack();
+			getStatistics()->getPlayer().attack();
 
-			debugPrint( " !! strike: " + toString(m_self->getId())
-				+ toString(m_self->getX()) + "," + toString(m_self->getY()) + "; s " 
-				+ toString(m_self->getSpeedX()) + ", " + toString(m_self->getSpeedY()));
+			LOG(" !! strike: {} {},{}; s {}, {}", m_self->getId(), m_self->getX(), m_self->getY(), m_self->getSpeedX(), m_self->getSpeedY());
 		}
 		else
 		{
-			debugPrint(" .. cooldown");
+			LOG(" .. cooldown");
 		}
 		return;
 	}
@@ -190,8 +221,7 @@ void MyStrategy::attackNet()
 		const double  downQuater = (m_game->getRinkBottom() + center) / 2;
 
 		double theirOrMinePart = m_self->getDistanceTo(opponent.getNetFront(), center) / m_self->getDistanceTo(me.getNetFront(), center);
-		static const double kFarFromOpponentFactor = 2;
-		if (theirOrMinePart > kFarFromOpponentFactor)
+		if (theirOrMinePart > m_parameters[Parameters::eFAR_FROM_OPPONENT_FACTOR])
 		{
 			// how much is present of opponent in each half?
 			double upScore   = 0;
@@ -210,25 +240,28 @@ void MyStrategy::attackNet()
 			downScore -= std::abs(downQuater - m_self->getY());
 
 			// choose half with less enemies score
-			static const double k_minFactor = (m_game->getRinkBottom() - m_game->getRinkTop()) / 1.5;
+			const double k_minFactor = (m_game->getRinkBottom() - m_game->getRinkTop()) / m_parameters[Parameters::eQUARTER_SCORE_FACTOR];
 			double quatersFactor = std::abs(upScore - downScore);
 			if (quatersFactor > k_minFactor)
 			{
 				m_firePositionMap[m_self->getId()] = upScore < downScore ? PreferredFire::eDOWN : PreferredFire::eUP;
-				Statistics::instance()->registerOnPuckLoose( [](){m_firePositionMap.clear();} );
 			}
 		}
 	}
 
-	const Point net       = getNet(m_world->getOpponentPlayer(), *m_self);
-	const Point firePoint = getFirePoint();
+	// fire point and the net corner to strike at are chosen together and kept with the plan
+	if (!m_plan->hasTarget())
+		m_plan->setTarget(getFirePoint(), getNet(m_world->getOpponentPlayer(), *m_self));
+
+	const Point firePoint = m_plan->getTarget();
+	const Point net       = m_plan->getAim();
 
 	// TODO - variable [0, 10, 20] strike time?
-	unsigned strikeTime = static_cast<unsigned>(m_game->getSwingActionCooldownTicks() + abs(m_self->getAngleTo(net.x, net.y) / m_game->getHockeyistTurnAngleFactor()));
-	const Hockeyist ghost = getGhost(*m_self, strikeTime, m_self->getAngle());
+	const double turnSpeed  = m_game->getHockeyistTurnAngleFactor() * m_parameters[Parameters::eTURN_SCALE] * m_attributes.get(*m_self).m_agility;
+	unsigned     strikeTime = static_cast<unsigned>(m_game->getSwingActionCooldownTicks() + abs(m_self->getAngleTo(net.x, net.y) / turnSpeed));
+	const UnitState ghost = getGhost(*m_self, strikeTime, m_self->getAngle(), 1.0);
 
 	double angleToNet       = ghost.getAngleTo(net.x, net.y);
-	double angleToFirePoint = m_self->getAngleTo(firePoint.x, firePoint.y);
 	double distanceToFire   = ghost.getDistanceTo(firePoint.x, firePoint.y);
 
 	if (distanceToFire < m_self->getRadius() * 2) // start aiming a bit before fire point
@@ -241,17 +274,21 @@ void MyStrategy::attackNet()
 		{
 			m_move->setAction(ActionType::SWING);
 
-			debugPrint( " ?? strike prediction: " + toString(m_self->getId()) 
-				+ "g: " + toString(ghost.getX()) + "," + toString(ghost.getY()) 
-				+ "; s: " + toString(m_self->getX()) + "," + toString(m_self->getY())
-				+ "; v: " + toString(ghost.getSpeedX()) + ", " + toString(ghost.getSpeedY()) 
-				+ "; dt: " + toString(strikeTime));
+			LOG(" ?? strike prediction: {} g: {},{}; s: {},{}; v: {}, {}; dt: {}", m_self->getId(), ghost.m_x, ghost.m_y,
+				m_self->getX(), m_self->getY(), ghost.m_speedX, ghost.m_speedY, strikeTime);
 		}
 	}
 	else
 	{
-		// move to fire point. TODO: obstacles?
-		m_move->setTurn(angleToFirePoint);
+		// move to fire point around opponents, path is kept until somebody crosses it
+		if (!m_plan->hasPath())
+		{
+			m_pathPlanner.build(*m_world, *m_game, m_self->getRadius());
+			m_plan->setPath(m_pathPlanner.findPath(Point(m_self->getX(), m_self->getY()), firePoint));
+		}
+
+		const Point& waypoint = m_plan->nextWaypoint(*m_self);
+		m_move->setTurn(m_self->getAngleTo(waypoint.x, waypoint.y));
 		m_move->setSpeedUp(1.0);
 		improveManeuverability(); // TODO - check me!
 	}
@@ -261,9 +298,9 @@ void MyStrategy::haveRest()
 {
 	Point exit = getSubstitutionPoint();
 	
-	static const double substitutionDistance = m_game->getSubstitutionAreaHeight();
-	static const double fastRunDistance = substitutionDistance * 3;
-	const double        currentDistance = m_self->getDistanceTo(exit.x, exit.y);
+	const double substitutionDistance = m_game->getSubstitutionAreaHeight();
+	const double fastRunDistance      = substitutionDistance * 3;
+	const double currentDistance      = m_self->getDistanceTo(exit.x, exit.y);
 	if (currentDistance > substitutionDistance)
 	{
 		m_move->setTurn(m_self->getAngleTo(exit.x, exit.y));
@@ -291,20 +328,20 @@ MyStrategy::TActionPtr MyStrategy::getCurrentAction()
 		return &MyStrategy::haveRest;
 
 	// is it time to start initial defend on sub-round begin?
-	const PuckStatistics& puckStatistics = Statistics::instance()->getPuck();
+	const PuckStatistics& puckStatistics = getStatistics()->getPuck();
 	if (puckStatistics.m_isFirstCatch)
 	{
 		findInitialDefender();
 		if (puckStatistics.m_lastPlayerId != m_world->getMyPlayer().getId())
 		{
-			debugPrint( "Tick: " + toString(m_world->getTick()) + " initial defend needed" );
+			LOG("Tick: {} initial defend needed", m_world->getTick());
 
 			if (m_self->getId() == m_initialDefenderId)
 				return &MyStrategy::defendInitial;
 		}
 		else if(m_initialDefenderId != -1)
 		{
-			debugPrint( "Tick: " + toString(m_world->getTick()) + " initial defend finished" );
+			LOG("Tick: {} initial defend finished", m_world->getTick());
 			m_initialDefenderId = -1;
 		}
 	}
@@ -324,6 +361,21 @@ MyStrategy::TActionPtr MyStrategy::getCurrentAction()
 	return &MyStrategy::attackPuck;
 }
 
+DecisionTrace::Behaviour MyStrategy::getBehaviour(TActionPtr action)
+{
+	if (action == &MyStrategy::attackPuck)
+		return DecisionTrace::eATTACK_PUCK;
+	if (action == &MyStrategy::attackNet)
+		return DecisionTrace::eATTACK_NET;
+	if (action == &MyStrategy::defendTeammate)
+		return DecisionTrace::eDEFEND_TEAMMATE;
+	if (action == &MyStrategy::defendInitial)
+		return DecisionTrace::eDEFEND_INITIAL;
+	if (action == &MyStrategy::haveRest)
+		return DecisionTrace::eHAVE_REST;
+	return DecisionTrace::eNONE;
+}
+
 // ======================================================================================
 
 Point MyStrategy::getNet(const Player& player, const Hockeyist& attacker, PreferredFire preffered) const
@@ -340,15 +392,17 @@ Point MyStrategy::getNet(const Player& player, const Hockeyist& attacker, Prefer
 
 void MyStrategy::defendTeammate()
 {
-	static const double kSAFE_ANGLE      = m_game->getStrikeAngleDeviation() + STRIKE_ANGLE;
-	static const double kDANGEROUS_ANGLE = m_game->getStickSector() / 2;
+	const double kSAFE_ANGLE      = m_game->getStrikeAngleDeviation() + STRIKE_ANGLE;
+	const double kDANGEROUS_ANGLE = m_game->getStickSector() / 2;
 
 	const Player& me = m_world->getMyPlayer();
-	const double netX = me.getNetFront()	+ m_self->getRadius() * (Statistics::instance()->getMySide() == Statistics::eLEFT_SIDE ? -2 : 2);
+	const double netX = me.getNetFront()	+ m_self->getRadius() * (getStatistics()->getMySide() == Statistics::eLEFT_SIDE ? -2 : 2);
 	const double netY = (me.getNetTop() + me.getNetBottom()) / 2;
 
 	const Hockeyist* nearestSafe   = nullptr;
 	const Hockeyist* nearestUnsafe = nullptr;
+	double           safeDistance   = 0;
+	double           unsafeDistance = 0;
 	const Puck&      puck          = m_world->getPuck();
 	const Hockeyist* vip           = find_unit(getHockeyists(), [&puck](const Hockeyist& h){return h.getId() == puck.getOwnerHockeyistId();} );
 
@@ -367,21 +421,26 @@ void MyStrategy::defendTeammate()
 		bool isSafe = true;
 		if (distance < m_game->getStickLength())
 		{
-			const Hockeyist attacking = getGhost(*m_self, 0, m_self->getAngle() + angle);
+			const UnitState attacking = getGhost(*m_self, 0, m_self->getAngle() + angle);
 			if (attacking.getAngleTo(puck) < kSAFE_ANGLE || attacking.getAngleTo(*vip) < kSAFE_ANGLE)
 				isSafe = false;
 		}
 
+		// stronger opponent knocks our puck owner down more likely, so treat him as nearer one
+		const double threatDistance = distance / std::max(m_attributes.get(h).m_strength, 0.01);
+
 		typedef const Hockeyist* TPtr;
-		TPtr& nearest = isSafe ? nearestSafe : nearestUnsafe;
+		TPtr&   nearest         = isSafe ? nearestSafe  : nearestUnsafe;
+		double& nearestDistance = isSafe ? safeDistance : unsafeDistance;
 
-		if (nearest == nullptr || distance < m_self->getDistanceTo(nearest->getX(), nearest->getY()))
+		if (nearest == nullptr || threatDistance < nearestDistance)
 		{
-			nearest = &h;
+			nearest         = &h;
+			nearestDistance = threatDistance;
 		}
 	}
 	
-	static const double centerX = (m_game->getRinkRight() - m_game->getRinkLeft()) / 2;
+	const double centerX = (m_game->getRinkRight() - m_game->getRinkLeft()) / 2;
 	const Hockeyist* nearest = nearestSafe ? nearestSafe : nearestUnsafe;
     if (!nearest)
 	{
@@ -410,7 +469,7 @@ void MyStrategy::defendTeammate()
 	{
 		if (isCanStrike)
 		{
-			Hockeyist attacking   = getGhost(*m_self, 0, m_self->getAngle() + angleToNearest);
+			UnitState attacking   = getGhost(*m_self, 0, m_self->getAngle() + angleToNearest);
 			double    angleToPuck = attacking.getAngleTo(puck);
 			double    angleToVip  = attacking.getAngleTo(*vip);
 			double    teammateDistance = std::min(attacking.getDistanceTo(puck), attacking.getDistanceTo(*vip));
@@ -458,7 +517,7 @@ void MyStrategy::defendTeammate()
 		else
 		{
 			// take attack position between enemy and my net
-			static const  double stickLength = m_game->getStickLength();
+			const double stickLength = m_game->getStickLength();
 			double attackDistance = std::min(stickLength, m_self->getRadius() * 2);
 			double dx = 0;
 			double dy = 0;
@@ -472,7 +531,7 @@ void MyStrategy::defendTeammate()
 			}
 			else
 			{
-				debugPrint("Opponent is too close, try punching from this position");
+				LOG("Opponent is too close, try punching from this position");
 			}
 
 			m_move->setSpeedUp(1.0);
@@ -500,31 +559,46 @@ Point MyStrategy::getEstimatedPuckPos() const
 		double speed = sqrt(xSpeed*xSpeed + ySpeed*ySpeed);
 		double time  = speed > 0.1 ? distance / speed : 0;
 
-		double predictX = puck.getX() + time * puck.getSpeedX() / 2.0;  // TODO: friction
-		double predictY = puck.getY() + time * puck.getSpeedY() / 2.0;  // TODO: friction
-
-		if (predictX > 0 && predictX < m_world->getWidth() && predictY > 0 && predictY < m_world->getHeight())
+		const Motion predicted = predictPuck(puck, time);
+		if (predicted.m_x > 0 && predicted.m_x < m_world->getWidth() && predicted.m_y > 0 && predicted.m_y < m_world->getHeight())
 		{
-			result = Point(predictX, predictY);
+			result = Point(predicted.m_x, predicted.m_y);
 		}
 	}
 
 	return result;
 }
 
+Motion MyStrategy::predictPuck(const model::Puck& puck, double ticks) const
+{
+	const Motion from(puck.getX(), puck.getY(), puck.getSpeedX(), puck.getSpeedY());
+	if (m_parameters.getInt(Parameters::eCLOSED_FORM_PHYSICS))
+		return Physics::predict(from, m_parameters[Parameters::ePUCK_FRICTION], static_cast<unsigned>(ticks + 0.5));
+
+	// contest approximation: half the current speed on average
+	return Motion(from.m_x + ticks * from.m_speedX / 2.0, from.m_y + ticks * from.m_speedY / 2.0, from.m_speedX, from.m_speedY);
+}
+
 Point MyStrategy::getFirePoint() const
 {
-	const auto& hockeyists = getHockeyists();
-	
-	bool isGoalkeeperPresent = find_unit(hockeyists, [](const Hockeyist& h){ return !h.isTeammate() && h.getType() == GOALIE;} ) != nullptr;
-	if (!isGoalkeeperPresent) 
+	// goalies leave the ice in overtime, so this is checked on every call
+	const bool isGoalkeeperPresent = find_unit(getHockeyists(), [](const Hockeyist& h){ return !h.isTeammate() && h.getType() == GOALIE;} ) != nullptr;
+	return (this->*m_firePoints[isGoalkeeperPresent ? 1 : 0])();
+}
+
+template <int TeamSize, bool HasGoalie>
+Point MyStrategy::getFirePoint() const
+{
+	if (!HasGoalie) 
 	{
 		// if no goalkeeper present - fire from any position
 		return Point(m_self->getX(), m_self->getY());
 	}
 
 	// find 45 degree line for fire from
-	TFirePositions positions = fillFirePositions();
+	TFirePositions positions = fillFirePositions<TeamSize, HasGoalie>();
+	if (m_trace)
+		m_trace->m_candidates = static_cast<unsigned short>(positions.size());
 
 	// sort positions by < (distance+penalty)
 	std::sort( begin(positions), end(positions), 
@@ -539,17 +613,40 @@ Point MyStrategy::getFirePoint() const
 	return fire;
 }
 
+template <int TeamSize, bool HasGoalie>
 MyStrategy::TFirePositions MyStrategy::fillFirePositions() const
 {
-	TFirePositions positions;
-	static const int    top       = static_cast<int>(m_game->getRinkTop());
-	static const int    bottom    = static_cast<int>(m_game->getRinkBottom());
-	static const double netHeight = m_world->getOpponentPlayer().getNetBottom() - m_world->getOpponentPlayer().getNetTop();
-	static const int    width     = static_cast<int>(m_game->getWorldWidth());
+	// opponents in world order, goalie included; their number is fixed when the team size is known
+	static const int kOPPONENT_COUNT = TeamSize + (HasGoalie ? 1 : 0);
+	static const int kMAX_OPPONENTS  = TeamSize == kANY_TEAM_SIZE ? static_cast<int>(THockeyists::capacity()) : kOPPONENT_COUNT;
+
+	const Hockeyist* opponents[kMAX_OPPONENTS];
+	int opponentCount = 0;
+	for (const Hockeyist& h: getHockeyists())
+	{
+		if (h.isTeammate())
+			continue;
+		if (opponentCount < kMAX_OPPONENTS)
+			opponents[opponentCount] = &h;
+		++opponentCount;
+	}
+
+	// not the game variant this was instantiated for
+	if (TeamSize != kANY_TEAM_SIZE && opponentCount != kOPPONENT_COUNT)
+		return fillFirePositions<kANY_TEAM_SIZE, HasGoalie>();
+
+	PROFILE_SCOPE("fillFirePositions");
+
+	TFirePositions positions((ScratchAllocator<FirePosition>(m_scratch)));
+	const int    top       = static_cast<int>(m_game->getRinkTop());
+	const int    bottom    = static_cast<int>(m_game->getRinkBottom());
+	const double netHeight = m_world->getOpponentPlayer().getNetBottom() - m_world->getOpponentPlayer().getNetTop();
+	const int    width     = static_cast<int>(m_game->getWorldWidth());
 	int unitRadius = static_cast<int>(m_self->getRadius());
 
-	const auto& hockeists = getHockeyists();
-	const Hockeyist* goalkeeper = find_unit(hockeists, [](const Hockeyist& h){ return !h.isTeammate() && h.getType() == GOALIE;});
+	const double kMAX_STICK_ANGLE = m_game->getStickSector()/2;
+	const double kPUCK_SIZE       = m_world->getPuck().getRadius();
+	const double kSTICK_LENGTH    = m_game->getStickLength();
 
 	positions.reserve(std::min(bottom - top, width) / unitRadius * 2);
 
@@ -565,7 +662,7 @@ MyStrategy::TFirePositions MyStrategy::fillFirePositions() const
 	int yDirection = fireFrom == PreferredFire::eDOWN ? 1 : -1;
 	
 	double yThreshold = yDirection > 0 ? bottom - unitRadius : top + unitRadius;
-    double yMargin    = yDirection * (goalkeeper ?  netHeight : unitRadius * 2);   // don't go too close to goalkeeper.
+    double yMargin    = yDirection * (HasGoalie ?  netHeight : unitRadius * 2);   // don't go too close to goalkeeper.
 
     auto isBottomCrossed = [yThreshold](double y){return y > yThreshold;};
     auto isTopCrossed    = [yThreshold](double y){return y < yThreshold;};
@@ -580,15 +677,10 @@ MyStrategy::TFirePositions MyStrategy::fillFirePositions() const
 		bool isEnemyAtPosition = false;
 		bool isEnemyInBetween  = false;
 		bool isEnemyStickThere = false;
-		for (const Hockeyist& h: hockeists)
+		// constant trip count for a known team size, the loop unrolls
+		for (int i = 0; i < (TeamSize == kANY_TEAM_SIZE ? opponentCount : kOPPONENT_COUNT); ++i)
 		{
-			static const double kMAX_STICK_ANGLE     = m_game->getStickSector()/2;
-			static const double kPUCK_SIZE           = m_world->getPuck().getRadius();
-			static const double kSTICK_LENGTH        = m_game->getStickLength();
-
-			if(h.isTeammate())
-				continue;
-
+			const Hockeyist& h = *opponents[i];
 			const double enemyDistance = h.getDistanceTo(x, y);
 			const double enemyAngle    = std::abs(h.getAngleTo(x, y));
 			isEnemyAtPosition = isEnemyAtPosition || ( enemyDistance <= h.getRadius() && enemyAngle <= PI / 2 );
@@ -596,26 +688,36 @@ MyStrategy::TFirePositions MyStrategy::fillFirePositions() const
 			isEnemyInBetween  = isEnemyInBetween  || ( !isEnemyAtPosition && enemyAngle <= PI / 2 && isInBetween(Point(x,y), h, *m_self, kPUCK_SIZE) );
 		}
 
-		static const int kENEMY_PENALTY         = 180; 
-		static const int kENEMY_BETWEEN_PENALTY = 165; 
-		static const int kENEMY_STICK_PENALTY   = 60;
 		if (isEnemyAtPosition)
-			penalty += kENEMY_PENALTY;
+			penalty += m_parameters.getInt(Parameters::eENEMY_PENALTY);
 		if (isEnemyInBetween)
-			penalty += kENEMY_BETWEEN_PENALTY;
+			penalty += m_parameters.getInt(Parameters::eENEMY_BETWEEN_PENALTY);
 		if (isEnemyStickThere)
-			penalty += kENEMY_STICK_PENALTY;
+			penalty += m_parameters.getInt(Parameters::eENEMY_STICK_PENALTY);
 
 		positions.push_back(FirePosition(Point(x, y), static_cast<int>(m_self->getDistanceTo(x, y)), penalty));
 	}
 
+	PROFILE_COUNT("fire candidates", positions.size());
 	return positions;
 }
 
+// called directly by tools/StrategyBenchmark
+template MyStrategy::TFirePositions MyStrategy::fillFirePositions<MyStrategy::kANY_TEAM_SIZE, false>() const;
+template MyStrategy::TFirePositions MyStrategy::fillFirePositions<MyStrategy::kANY_TEAM_SIZE, true>() const;
+template MyStrategy::TFirePositions MyStrategy::fillFirePositions<2, false>() const;
+template MyStrategy::TFirePositions MyStrategy::fillFirePositions<2, true>() const;
+template MyStrategy::TFirePositions MyStrategy::fillFirePositions<3, false>() const;
+template MyStrategy::TFirePositions MyStrategy::fillFirePositions<3, true>() const;
+template MyStrategy::TFirePositions MyStrategy::fillFirePositions<6, false>() const;
+template MyStrategy::TFirePositions MyStrategy::fillFirePositions<6, true>() const;
+
 
 MyStrategy::TFirePositions MyStrategy::fillDefenderPositions(const model::Hockeyist* attacker, const model::Hockeyist* defender) const
 {
-	TFirePositions positions;
+	PROFILE_SCOPE("fillDefenderPositions");
+
+	TFirePositions positions((ScratchAllocator<FirePosition>(m_scratch)));
 	int top        = static_cast<int>(m_game->getRinkTop());
 	int bottom     = static_cast<int>(m_game->getRinkBottom());
 	int width      = static_cast<int>(m_game->getWorldWidth());
@@ -630,11 +732,12 @@ MyStrategy::TFirePositions MyStrategy::fillDefenderPositions(const model::Hockey
 	{
 		// attacker is not decided yet, just go back to goalie
 		double goalkeeperX = goalkeeper ? goalkeeper->getX() : m_world->getMyPlayer().getNetFront();
-		double targetX     = Statistics::instance()->getMySide() == Statistics::eLEFT_SIDE
+		double targetX     = getStatistics()->getMySide() == Statistics::eLEFT_SIDE
 			? goalkeeperX + m_self->getRadius() * 4
 			: goalkeeperX - m_self->getRadius() * 4;
 
-		return TFirePositions(1, FirePosition(Point(targetX, defender->getY()), 0, 0));
+		positions.push_back(FirePosition(Point(targetX, defender->getY()), 0, 0));
+		return positions;
 	}
 
 	positions.reserve(std::min(bottom - top, width) / unitRadius * 2);
@@ -663,6 +766,7 @@ MyStrategy::TFirePositions MyStrategy::fillDefenderPositions(const model::Hockey
 		positions.push_back(FirePosition(Point(x, y), static_cast<int>(m_self->getDistanceTo(x, y)), penalty));
 	}
 
+	PROFILE_COUNT("defender candidates", positions.size());
 	return positions;
 }
 
@@ -672,7 +776,7 @@ void MyStrategy::updateStatistics()
 	const Player& me = m_world->getMyPlayer();
 
 	// init statistics
-	if (!Statistics::instance())
+	if (!getStatistics())
 	{
 		Point topLeftRink       = Point(m_game->getRinkLeft(),  m_game->getRinkTop());
 		Point bottomRightRink   = Point(m_game->getRinkRight(), m_game->getRinkTop() + m_game->getSubstitutionAreaHeight());
@@ -690,40 +794,67 @@ void MyStrategy::updateStatistics()
 			topLeftRink.x = bottomRightRink.x / 2.0;
 		}
 		
-		Statistics::init(Range(topLeftRink, bottomRightRink), mySide, m_world->getMyPlayer().getName());
+		m_team.m_statistics.reset(new Statistics(Range(topLeftRink, bottomRightRink), mySide, me.getId(), me.getName()));
+		m_events.subscribe(EventType::ePUCK_OWNER_CHANGED, &MyStrategy::onPuckOwnerChanged, &m_team);
+
+		// per-hockeyist state of the whole roster, resting ones included, so later ticks don't allocate
+		for (const Hockeyist& h: getHockeyists())
+		{
+			if (h.isTeammate())
+			{
+				m_plans[h.getId()];
+				m_firePositionMap[h.getId()];
+			}
+		}
 	}
 
 	// update player statistics
-	Statistics::instance()->getPlayer().update(me.getGoalCount(), m_world->getOpponentPlayer().getGoalCount(), me.isStrategyCrashed());
+	getStatistics()->getPlayer().update(me.getGoalCount(), m_world->getOpponentPlayer().getGoalCount(), me.isStrategyCrashed());
 
-	// update puck statistics
-	PuckStatistics& puckStatistics = Statistics::instance()->getPuck();
+	// reset puck statistics on goal, changes of its owner come from onPuckOwnerChanged()
+	PuckStatistics& puckStatistics = getStatistics()->getPuck();
 	if (isRestTime() && !puckStatistics.m_isJustReset)
 	{
 		puckStatistics.reset();
 		m_initialDefenderId = -1;
 	}
-	else
-	{
-		long long puckPlayerId = m_world->getPuck().getOwnerPlayerId();
+}
 
-		if (puckStatistics.m_lastPlayerId != puckPlayerId)
-		{
-			if (puckPlayerId != m_world->getMyPlayer().getId())
-				Statistics::instance()->onPuckLoose();
+void MyStrategy::onPuckOwnerChanged(void* context, const Event& e)
+{
+	TeamContext& team = *static_cast<TeamContext*>(context);
 
-			puckStatistics.m_isFirstCatch = puckStatistics.m_isJustReset;
-			puckStatistics.m_lastPlayerId = puckPlayerId;
-			puckStatistics.m_isJustReset  = false;
-		}
+	// every kept plan was made for the previous owner
+	for (auto& plan: team.m_plans)
+		plan.second.onPuckOwnerChanged();
+
+	if (e.m_playerId == e.m_previousPlayerId)
+		return;
+
+	PuckStatistics& puckStatistics = team.m_statistics->getPuck();
+	puckStatistics.m_isFirstCatch = puckStatistics.m_isJustReset;
+	puckStatistics.m_lastPlayerId = e.m_playerId;
+	puckStatistics.m_isJustReset  = false;
+
+	// preferred fire side is chosen while we own the puck and forgotten as soon as it's lost;
+	// entries are reset rather than erased, so the map doesn't reallocate its nodes every possession
+	if (e.m_playerId != team.m_statistics->getMyPlayerId())
+	{
+		for (auto& preferred: team.m_firePositionMap)
+			preferred.second = PreferredFire::eUNKNOWN;
 	}
 }
 
+Statistics* MyStrategy::getStatistics() const
+{
+	return m_team.m_statistics.get();
+}
+
 Point MyStrategy::getSubstitutionPoint() const
 {
 	Point                  result      = Point(m_self->getX(), m_self->getY());
-	const Range            targetRange = Statistics::instance()->getSubstitutionRange();
-	const Statistics::Side mySide      = Statistics::instance()->getMySide();
+	const Range            targetRange = getStatistics()->getSubstitutionRange();
+	const Statistics::Side mySide      = getStatistics()->getMySide();
 	
 	if (targetRange.isPointInside(result))
 		return result;
@@ -739,15 +870,38 @@ Point MyStrategy::getSubstitutionPoint() const
 	return result;
 }
 
-model::Hockeyist MyStrategy::getGhost(const model::Hockeyist& from, unsigned ticksIncrement, double overrideAngle)
+UnitState MyStrategy::getGhost(const model::Hockeyist& from, unsigned ticksIncrement, double overrideAngle, double speedUp)
 {
-	static const double kFrictionLoses = 0.95;
-	const double speedLose = pow(kFrictionLoses, ticksIncrement);
+	PROFILE_COUNT("ghosts", 1);
+
+	// acceleration along current direction, agility and stamina dependent
+	const double speedFactor  = speedUp > 0
+		? m_game->getHockeyistSpeedUpFactor()   * m_parameters[Parameters::eSPEED_UP_SCALE]
+		: m_game->getHockeyistSpeedDownFactor() * m_parameters[Parameters::eSPEED_DOWN_SCALE];
+	const double acceleration = speedUp * speedFactor * m_attributes.get(from).m_agility;
+
+	const double ax       = std::cos(from.getAngle()) * acceleration;
+	const double ay       = std::sin(from.getAngle()) * acceleration;
+	const double friction = m_parameters[Parameters::eHOCKEYIST_FRICTION];
 
-	double x = from.getX() + from.getSpeedX() * ticksIncrement * kFrictionLoses;
-	double y = from.getY() + from.getSpeedY() * ticksIncrement * kFrictionLoses;
-	return Hockeyist(0, 0, 0, 0, from.getRadius(),  x, y, from.getSpeedX() * speedLose, from.getSpeedY() * speedLose, overrideAngle, from.getAngularSpeed(), 
-		from.isTeammate(), from.getType(), 0, 0, 0, 0, 0, from.getState(), 0, 0, 0, 0, from.getLastAction(), from.getLastActionTick());
+	UnitState ghost = UnitState::from(from);
+	if (m_parameters.getInt(Parameters::eCLOSED_FORM_PHYSICS))
+	{
+		ghost.setMotion(Physics::predict(ghost.getMotion(), ax, ay, friction, ticksIncrement));
+	}
+	else
+	{
+		// contest approximation: friction loses its share of the whole path once, acceleration isn't slowed down
+		const double speedLose        = pow(friction, ticksIncrement);
+		const double accelerationPath = ticksIncrement * ticksIncrement / 2.0;
+		ghost.setMotion(Motion(
+			from.getX() + from.getSpeedX() * ticksIncrement * friction + ax * accelerationPath,
+			from.getY() + from.getSpeedY() * ticksIncrement * friction + ay * accelerationPath,
+			from.getSpeedX() * speedLose + ax * ticksIncrement,
+			from.getSpeedY() * speedLose + ay * ticksIncrement));
+	}
+	ghost.m_angle = overrideAngle;
+	return ghost;
 }
 
 void MyStrategy::findInitialDefender()
@@ -772,6 +926,12 @@ void MyStrategy::findInitialDefender()
 	m_initialDefenderId = nearestTeammate ? nearestTeammate->getId() : -1;
 }
 
+Plan::Situation MyStrategy::getSituation() const
+{
+	const PuckStatistics& puckStatistics = getStatistics()->getPuck();
+	return Plan::Situation(m_initialDefenderId, isRestTime(), puckStatistics.m_isFirstCatch);
+}
+
 const model::Hockeyist* MyStrategy::getPuckOwner() const
 {
 	long long ownerUnitId = m_world->getPuck().getOwnerHockeyistId();
@@ -804,8 +964,8 @@ bool MyStrategy::isInBetween(const Point& first, const model::Unit& inBetween, c
 
 void MyStrategy::improveManeuverability()
 {
-	static const double kBrakeAngleThreshold = PI/4;
-	static const double kBrakeSpeedThreshold = m_game->getHockeyistSpeedDownFactor();
+	const double kBrakeAngleThreshold = m_parameters[Parameters::eBRAKE_ANGLE_THRESHOLD];
+	const double kBrakeSpeedThreshold = m_game->getHockeyistSpeedDownFactor();
 	if (std::abs(m_move->getTurn()) > kBrakeAngleThreshold && toVectorSpeed(m_self->getSpeedX(), m_self->getSpeedY()) > kBrakeSpeedThreshold)
 	{
 		// TODO: try to move backwards if reasonable?
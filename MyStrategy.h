@@ -5,26 +5,54 @@
 
 #include "Strategy.h"
 #include "Utils.h"
+#include "Plan.h"
+#include "DecisionTrace.h"
+#include "Physics.h"
+#include "ScratchArena.h"
 #include <memory>
 #include <map>
 
 class Statistics;
+class StealModel;
+class AttributeCache;
+class EventBus;
+class Parameters;
+struct Event;
+struct TeamContext;
 
 class MyStrategy : public Strategy 
 {
+	friend class StrategyBenchmark;
+	friend class PredictionCheck;
+
 	typedef void (MyStrategy::* TActionPtr)();
-	typedef std::vector<FirePosition>     TFirePositions;
-	typedef std::vector<model::Hockeyist> THockeyists;
+	typedef Point (MyStrategy::* TFirePointPtr)() const;
+	typedef ScratchVector<FirePosition>   TFirePositions;
+	typedef model::Hockeyists             THockeyists;
 	typedef long long                     TId;
 
 	const model::Hockeyist* m_self;
 	const model::World*     m_world; 
 	const model::Game*      m_game; 
 	model::Move*            m_move;
+	Plan*                   m_plan;
+	DecisionTrace::Row*     m_trace;    // current decision trace row, nullptr if not tracing
+	TFirePointPtr           m_firePoints[2]; // [without, with] opponent goalie, instantiated for the team size
 
 	static const double                 STRIKE_ANGLE;
-	static TId                          m_initialDefenderId;
-	static std::map<TId, PreferredFire> m_firePositionMap;  // id of hockeyist which wants to fire from far (not near!) angle
+
+	// shared with teammates, see TeamContext
+	TeamContext&                  m_team;
+	const Parameters&             m_parameters;
+	TId&                          m_initialDefenderId;
+	std::map<TId, PreferredFire>& m_firePositionMap;
+	PathPlanner&                  m_pathPlanner;
+	StealModel&                   m_stealModel;
+	AttributeCache&               m_attributes;
+	std::map<TId, Plan>&          m_plans;
+	EventBus&                     m_events;
+	ScratchArena&                 m_scratch;
+	DecisionTrace&                m_decisionTrace;
 
 	void update(const model::Hockeyist* self, const model::World* world, const model::Game* game, model::Move* move)
 	{
@@ -35,11 +63,16 @@ class MyStrategy : public Strategy
 	}
 
 public:
-    MyStrategy();
+	static const int kANY_TEAM_SIZE = 0;   //!< team size not known in advance, generic code paths
+
+	//! teamSize 2, 3 or 6 selects code specialized for it once, any other works with all sizes
+	explicit MyStrategy(TeamContext& team, int teamSize = kANY_TEAM_SIZE);
 	~MyStrategy();
 
     void move(const model::Hockeyist& self, const model::World& world, const model::Game& game, model::Move& move);
 
+	static bool isInBetween(const Point& first, const model::Unit& inBetween, const model::Unit& second, double gap);
+
 private:
 	//! get puck ownership
 	void attackPuck();
@@ -58,8 +91,11 @@ private:
 
 	//! get current strategy action
 	TActionPtr getCurrentAction();
+
+	static DecisionTrace::Behaviour getBehaviour(TActionPtr action);
 	
 	void updateStatistics();	
+	static void onPuckOwnerChanged(void* context, const Event& e);
 	
 	//! let Hockeyist use brakes, if needed
 	void improveManeuverability();
@@ -68,21 +104,27 @@ private:
 
 	Point getNet(const model::Player& player, const model::Hockeyist& attacker, PreferredFire preffered = PreferredFire::eUNKNOWN) const;        //! get preferred attack point in net
 	Point getEstimatedPuckPos() const;
+	Motion predictPuck(const model::Puck& puck, double ticks) const;      //! free puck, walls and units ignored
 	Point getFirePoint() const;
 	Point getSubstitutionPoint() const;
 
+	//! hot paths for a known team size (or kANY_TEAM_SIZE) and opponent goalie presence, selected once in ctor
+	template <int TeamSize> void specialize();
+	template <int TeamSize, bool HasGoalie> Point getFirePoint() const;
+
 	const THockeyists&      getHockeyists() const { return m_world->getHockeyists(); }
 	const model::Hockeyist* getPuckOwner() const;
+	Plan::Situation         getSituation() const;
+	Statistics*             getStatistics() const;
 
-	TFirePositions fillFirePositions() const;
+	template <int TeamSize, bool HasGoalie> TFirePositions fillFirePositions() const;
 	TFirePositions fillDefenderPositions(const model::Hockeyist* attacker, const model::Hockeyist* defender) const;
 	void findInitialDefender();
 
 	bool isRestTime() const {return m_world->getMyPlayer().isJustMissedGoal() || m_world->getOpponentPlayer().isJustMissedGoal(); }
-	static bool isInBetween(const Point& first, const model::Unit& inBetween, const model::Unit& second, double gap);
 
-	//! get ghost from the future
-	model::Hockeyist getGhost(const model::Hockeyist& from, unsigned ticksIncrement, double overrideAngle);
+	//! get ghost from the future, optionally speeding up (-1.0 .. 1.0) along current direction
+	UnitState getGhost(const model::Hockeyist& from, unsigned ticksIncrement, double overrideAngle, double speedUp = 0);
 };
 
 #endif
@@ -0,0 +1,99 @@
+#include "Parameters.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+	const Parameters::Info kINFO[Parameters::ePARAMETER_COUNT] =
+	{
+		{ "plan_lifetime",             15,     1,      60,     true,  true  },
+		{ "far_from_opponent_factor",  2,      1,      5,      false, true  },
+		{ "quarter_score_factor",      1.5,    0.5,    5,      false, true  },
+		{ "enemy_penalty",             180,    0,      500,    true,  true  },
+		{ "enemy_between_penalty",     165,    0,      500,    true,  true  },
+		{ "enemy_stick_penalty",       60,     0,      500,    true,  true  },
+		{ "brake_angle_threshold",     PI / 4, PI / 8, PI / 2, false, true  },
+		{ "defend_speed_up",           0.5,    0,      1,      false, true  },
+
+		{ "closed_form_physics",       0,      0,      1,      true,  false },
+		{ "hockeyist_friction",        0.95,   0.9,    1,      false, false },
+		{ "puck_friction",             0.999,  0.9,    1,      false, false },
+		{ "speed_up_scale",            1,      0.5,    2,      false, false },
+		{ "speed_down_scale",          1,      0.5,    2,      false, false },
+		{ "turn_scale",                1,      0.5,    2,      false, false },
+	};
+}
+
+Parameters::Parameters()
+{
+	for (int id = 0; id < ePARAMETER_COUNT; ++id)
+		m_values[id] = kINFO[id].m_default;
+}
+
+void Parameters::set(Id id, double value)
+{
+	const Info& info = kINFO[id];
+	value = std::max(info.m_min, std::min(info.m_max, value));
+	m_values[id] = info.m_isInteger ? std::floor(value + 0.5) : value;
+}
+
+const Parameters::Info& Parameters::getInfo(Id id)
+{
+	return kINFO[id];
+}
+
+bool Parameters::load(const std::string& path, std::string& error)
+{
+	FILE* file = std::fopen(path.c_str(), "r");
+	if (!file)
+	{
+		error = "can't open " + path;
+		return false;
+	}
+
+	char line[256];
+	for (int lineNumber = 1; std::fgets(line, sizeof(line), file); ++lineNumber)
+	{
+		if (char* comment = std::strchr(line, '#'))
+			*comment = 0;
+
+		char   name[128];
+		double value = 0;
+		const int fields = std::sscanf(line, "%127s %lf", name, &value);
+		if (fields <= 0)
+			continue;   // empty line
+
+		int id = 0;
+		while (id < ePARAMETER_COUNT && std::strcmp(kINFO[id].m_name, name) != 0)
+			++id;
+
+		if (fields != 2 || id == ePARAMETER_COUNT)
+		{
+			error = path + ":" + std::to_string(lineNumber) + (fields != 2 ? ": value expected" : ": unknown parameter ") + (fields != 2 ? "" : name);
+			std::fclose(file);
+			return false;
+		}
+
+		set(static_cast<Id>(id), value);
+	}
+
+	std::fclose(file);
+	return true;
+}
+
+bool Parameters::save(const std::string& path) const
+{
+	FILE* file = std::fopen(path.c_str(), "w");
+	if (!file)
+		return false;
+
+	for (int id = 0; id < ePARAMETER_COUNT; ++id)
+		std::fprintf(file, "%-26s %.10g\n", kINFO[id].m_name, m_values[id]);
+
+	return std::fclose(file) == 0;
+}
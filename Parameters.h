@@ -0,0 +1,63 @@
+#pragma once
+
+#ifndef _PARAMETERS_H_
+#define _PARAMETERS_H_
+
+#include <string>
+
+//! Strategy constants: tunable ones and measured physics. Defaults are what the contest build plays with, a text
+//! file of "name value" lines (# starts a comment) overrides some of them. tools/Tuner writes tunable ones,
+//! tools/Calibrator writes physics ones.
+class Parameters
+{
+public:
+	enum Id
+	{
+		ePLAN_LIFETIME = 0,             //!< ticks a decision is kept while situation doesn't change
+		eFAR_FROM_OPPONENT_FACTOR,      //!< choose fire half when distance to own net / opponent net is above
+		eQUARTER_SCORE_FACTOR,          //!< rink height / this is the minimal enemies score difference to choose a half
+		eENEMY_PENALTY,                 //!< fire position occupied by opponent
+		eENEMY_BETWEEN_PENALTY,         //!< opponent between hockeyist and fire position
+		eENEMY_STICK_PENALTY,           //!< fire position in opponent's stick reach
+		eBRAKE_ANGLE_THRESHOLD,         //!< brake if turning by more, radians
+		eDEFEND_SPEED_UP,               //!< defender's approach to the puck owner
+
+		eCLOSED_FORM_PHYSICS,           //!< 1: predict with the frictions below integrated per tick; 0: contest approximations
+		eHOCKEYIST_FRICTION,            //!< hockeyist speed multiplier per tick, with approximations also path share of speed
+		ePUCK_FRICTION,                 //!< free puck speed multiplier per tick, closed form only (approximation: half speed)
+		eSPEED_UP_SCALE,                //!< actual / game's hockeyist speed up factor
+		eSPEED_DOWN_SCALE,              //!< actual / game's hockeyist speed down factor
+		eTURN_SCALE,                    //!< actual / game's hockeyist turn angle factor
+		ePARAMETER_COUNT
+	};
+
+	struct Info
+	{
+		const char* m_name;
+		double      m_default;
+		double      m_min;
+		double      m_max;
+		bool        m_isInteger;
+		bool        m_isTunable;      //!< false for measured ones
+	};
+
+private:
+	double m_values[ePARAMETER_COUNT];
+
+public:
+	Parameters();
+
+	double operator[](Id id) const     { return m_values[id]; }
+	int    getInt(Id id) const         { return static_cast<int>(m_values[id] + 0.5); }
+
+	//! clamps to [min, max] of the parameter, rounds integer ones
+	void set(Id id, double value);
+
+	static const Info& getInfo(Id id);
+
+	//! false and error message on unknown name, bad value or unreadable file; values read before the error are kept
+	bool load(const std::string& path, std::string& error);
+	bool save(const std::string& path) const;
+};
+
+#endif
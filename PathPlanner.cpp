@@ -0,0 +1,206 @@
+#include "PathPlanner.h"
+#include "Profiler.h"
+#include <cassert>
+#include <limits>
+
+using namespace model;
+
+namespace
+{
+	inline double distance(const Point& a, const Point& b) { return toVectorSpeed(b.x - a.x, b.y - a.y); }
+
+	//! squared distance from p to segment [a, b]
+	double segmentDistance2(const Point& p, const Point& a, const Point& b)
+	{
+		const double dx  = b.x - a.x;
+		const double dy  = b.y - a.y;
+		const double len = dx * dx + dy * dy;
+		double t = len > 0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / len : 0;
+		t = std::max(0.0, std::min(1.0, t));
+
+		const double cx = a.x + t * dx - p.x;
+		const double cy = a.y + t * dy - p.y;
+		return cx * cx + cy * cy;
+	}
+}
+
+PathPlanner::PathPlanner()
+	: m_discCount(0)
+	, m_tick(-1)
+	, m_rink(Point(), Point())
+{
+}
+
+void PathPlanner::addDisc(const Point& center, double radius)
+{
+	assert(m_discCount < kMAX_DISCS);
+	if (m_discCount < kMAX_DISCS)
+		m_discs[m_discCount++] = Disc(center, radius);
+}
+
+void PathPlanner::build(const World& world, const Game& game, double selfRadius)
+{
+	if (m_tick == world.getTick())
+		return;
+
+	PROFILE_SCOPE("PathPlanner::build");
+	m_tick      = world.getTick();
+	m_discCount = 0;
+	m_rink      = Range(Point(game.getRinkLeft() + selfRadius, game.getRinkTop() + selfRadius), Point(game.getRinkRight() - selfRadius, game.getRinkBottom() - selfRadius));
+
+	// opponent may turn stick towards us while we pass by
+	static const int    kREACTION_TICKS = 5;
+	static const double kMAX_HALF_ANGLE = PI / 3;
+	const double halfSector = std::min(kMAX_HALF_ANGLE, game.getStickSector() / 2 + game.getHockeyistTurnAngleFactor() * kREACTION_TICKS);
+	const double stickLength = game.getStickLength();
+
+	for (const Hockeyist& h: world.getHockeyists())
+	{
+		if (h.isTeammate() || h.getState() == RESTING || h.getState() == KNOCKED_DOWN)
+			continue;
+
+		addDisc(Point(h.getX(), h.getY()), h.getRadius() + selfRadius);
+
+		if (h.getType() == GOALIE)
+			continue;
+
+		// smallest disc through stick sector apex and both arc ends
+		const double reachRadius = stickLength / (2 * std::cos(halfSector));
+		addDisc(Point(h.getX() + std::cos(h.getAngle()) * reachRadius, h.getY() + std::sin(h.getAngle()) * reachRadius), reachRadius + selfRadius);
+	}
+}
+
+bool PathPlanner::isSegmentFree(const Point& a, const Point& b, unsigned long long ignoredMask) const
+{
+	for (int i = 0; i < m_discCount; ++i)
+	{
+		if (ignoredMask & (1ull << i))
+			continue;
+
+		const double r = m_discs[i].m_radius;
+		if (segmentDistance2(m_discs[i].m_center, a, b) < r * r)
+			return false;
+	}
+
+	return true;
+}
+
+bool PathPlanner::isPointFree(const Point& p, unsigned long long ignoredMask) const
+{
+	if (!m_rink.isPointInside(p))
+		return false;
+
+	for (int i = 0; i < m_discCount; ++i)
+	{
+		if (ignoredMask & (1ull << i))
+			continue;
+
+		if (distance(p, m_discs[i].m_center) < m_discs[i].m_radius)
+			return false;
+	}
+
+	return true;
+}
+
+PathPlanner::Path PathPlanner::findPath(const Point& from, const Point& to)
+{
+	PROFILE_SCOPE("PathPlanner::findPath");
+	Path path;
+
+	unsigned long long ignoredMask = 0;
+	for (int i = 0; i < m_discCount; ++i)
+	{
+		if (distance(from, m_discs[i].m_center) < m_discs[i].m_radius || distance(to, m_discs[i].m_center) < m_discs[i].m_radius)
+			ignoredMask |= 1ull << i;
+	}
+
+	if (isSegmentFree(from, to, ignoredMask))
+	{
+		path.m_points[path.m_size++] = to;
+		path.m_length = distance(from, to);
+		return path;
+	}
+
+	// nodes: start, target and vertices of polygons circumscribed around each disc
+	static const double kMARGIN = 1.01 / std::cos(PI / kPOINTS_PER_DISC);
+	int nodeCount = 0;
+	m_nodes[nodeCount++] = from;
+	m_nodes[nodeCount++] = to;
+
+	for (int i = 0; i < m_discCount; ++i)
+	{
+		if (ignoredMask & (1ull << i))
+			continue;
+
+		const Disc& d = m_discs[i];
+		for (int k = 0; k < kPOINTS_PER_DISC; ++k)
+		{
+			const double angle = 2 * PI * k / kPOINTS_PER_DISC;
+			const Point  p     = Point(d.m_center.x + std::cos(angle) * d.m_radius * kMARGIN, d.m_center.y + std::sin(angle) * d.m_radius * kMARGIN);
+			if (isPointFree(p, ignoredMask))
+				m_nodes[nodeCount++] = p;
+		}
+	}
+
+	PROFILE_COUNT("path nodes", nodeCount);
+
+	// dense dijkstra, edges are checked lazily
+	for (int i = 0; i < nodeCount; ++i)
+	{
+		m_cost[i]   = std::numeric_limits<double>::max();
+		m_parent[i] = -1;
+		m_done[i]   = false;
+	}
+	m_cost[0] = 0;
+
+	for (;;)
+	{
+		int current = -1;
+		for (int i = 0; i < nodeCount; ++i)
+		{
+			if (!m_done[i] && m_cost[i] < std::numeric_limits<double>::max() && (current == -1 || m_cost[i] < m_cost[current]))
+				current = i;
+		}
+
+		if (current == -1 || current == 1)
+			break;
+
+		m_done[current] = true;
+		for (int next = 1; next < nodeCount; ++next)
+		{
+			if (m_done[next])
+				continue;
+
+			const double cost = m_cost[current] + distance(m_nodes[current], m_nodes[next]);
+			if (cost < m_cost[next] && isSegmentFree(m_nodes[current], m_nodes[next], ignoredMask))
+			{
+				m_cost[next]   = cost;
+				m_parent[next] = current;
+			}
+		}
+	}
+
+	if (m_parent[1] == -1)
+	{
+		// no safe path, go straight
+		path.m_points[path.m_size++] = to;
+		path.m_length   = distance(from, to);
+		path.m_isDirect = false;
+		return path;
+	}
+
+	int reversed[kMAX_NODES];
+	int reversedSize = 0;
+	for (int node = 1; node != 0; node = m_parent[node])
+		reversed[reversedSize++] = node;
+
+	// reversed[0] is the target and always ends the path; on a longer one the farthest intermediate
+	// waypoints are dropped, the plan expires and searches again long before they would be reached
+	for (int i = reversedSize - 1; i > 0 && path.m_size < kMAX_PATH - 1; --i)
+		path.m_points[path.m_size++] = m_nodes[reversed[i]];
+	path.m_points[path.m_size++] = m_nodes[reversed[0]];
+
+	path.m_length   = m_cost[1];
+	path.m_isDirect = false;
+	return path;
+}
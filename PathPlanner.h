@@ -0,0 +1,67 @@
+#pragma once
+
+#ifndef _PATH_PLANNER_H_
+#define _PATH_PLANNER_H_
+
+#include "Utils.h"
+#include "model/Game.h"
+#include "model/World.h"
+
+//! Visibility-graph planner around opponents. Discs are built once per tick, path queries are cheap enough to replan every tick.
+class PathPlanner
+{
+public:
+	struct Disc
+	{
+		Point  m_center;
+		double m_radius;
+
+		Disc(const Point& c = Point(), double r = 0) : m_center(c), m_radius(r) {}
+	};
+
+	static const int kMAX_DISCS          = 32;
+	static const int kPOINTS_PER_DISC    = 8;
+	static const int kMAX_NODES          = 2 + kMAX_DISCS * kPOINTS_PER_DISC;
+	static const int kMAX_PATH           = 16;
+
+	struct Path
+	{
+		Point    m_points[kMAX_PATH];   //!< waypoints, excluding start, including target
+		int      m_size;
+		double   m_length;
+		bool     m_isDirect;            //!< true if target is visible from start
+
+		Path() : m_size(0), m_length(0), m_isDirect(true) {}
+	};
+
+private:
+	Disc   m_discs[kMAX_DISCS];
+	int    m_discCount;
+	int    m_tick;
+	Range  m_rink;
+
+	//! scratch for graph search, kept as members to avoid per-query allocations
+	Point  m_nodes[kMAX_NODES];
+	double m_cost[kMAX_NODES];
+	int    m_parent[kMAX_NODES];
+	bool   m_done[kMAX_NODES];
+
+	void addDisc(const Point& center, double radius);
+	bool isSegmentFree(const Point& a, const Point& b, unsigned long long ignoredMask) const;
+	bool isPointFree(const Point& p, unsigned long long ignoredMask) const;
+
+public:
+	PathPlanner();
+
+	//! rebuild opponent discs inflated by own radius and opponent stick reach. No-op if already built for this tick.
+	void build(const model::World& world, const model::Game& game, double selfRadius);
+
+	//! shortest safe path from -> to. Discs covering start or target are ignored (we're already there or must go there anyway).
+	Path findPath(const Point& from, const Point& to);
+
+	int         getTick()      const { return m_tick; }
+	int         getDiscCount() const { return m_discCount; }
+	const Disc& getDisc(int i) const { return m_discs[i]; }
+};
+
+#endif
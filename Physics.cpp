@@ -0,0 +1,49 @@
+#include "Physics.h"
+#include "Utils.h"
+
+#include <cmath>
+
+double UnitState::getAngleTo(double x, double y) const
+{
+	// as model::Unit::getAngleTo, step for step
+	double relativeAngleTo = std::atan2(y - m_y, x - m_x) - m_angle;
+	while (relativeAngleTo > PI)
+		relativeAngleTo -= 2.0 * PI;
+	while (relativeAngleTo < -PI)
+		relativeAngleTo += 2.0 * PI;
+
+	return relativeAngleTo;
+}
+
+double UnitState::getDistanceTo(double x, double y) const
+{
+	const double xRange = x - m_x;
+	const double yRange = y - m_y;
+	return std::sqrt(xRange * xRange + yRange * yRange);
+}
+
+double Physics::getFrictionSum(double friction, unsigned ticks)
+{
+	if (std::abs(1 - friction) < 1e-9)
+		return ticks;
+
+	return (1 - std::pow(friction, static_cast<double>(ticks))) / (1 - friction);
+}
+
+Motion Physics::predict(const Motion& from, double ax, double ay, double friction, unsigned ticks)
+{
+	// speed before k-th tick is v * f^k + a * f * S(k), S(k) = sum of f^i for i < k, so
+	// path = v * S(n) + a * (n + f * sum of S(k) for k < n) and sum of S(k) is (n - S(n)) / (1 - f)
+	const double n         = ticks;
+	const double sum       = getFrictionSum(friction, ticks);
+	const double decay     = std::pow(friction, n);
+	const double sumOfSums = std::abs(1 - friction) < 1e-9 ? n * (n - 1) / 2 : (n - sum) / (1 - friction);
+	const double pathShare = n + friction * sumOfSums;    // of acceleration
+	const double speedGain = friction * sum;               // of acceleration
+
+	return Motion(
+		from.m_x + from.m_speedX * sum + ax * pathShare,
+		from.m_y + from.m_speedY * sum + ay * pathShare,
+		from.m_speedX * decay + ax * speedGain,
+		from.m_speedY * decay + ay * speedGain);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#ifndef _PHYSICS_H_
+#define _PHYSICS_H_
+
+#include "model/Unit.h"
+#include <type_traits>
+
+//! Position and speed of a unit
+struct Motion
+{
+	double m_x;
+	double m_y;
+	double m_speedX;
+	double m_speedY;
+
+	Motion() : m_x(0), m_y(0), m_speedX(0), m_speedY(0) {}
+	Motion(double x, double y, double speedX, double speedY) : m_x(x), m_y(y), m_speedX(speedX), m_speedY(speedY) {}
+};
+
+//! Kinematic state of a unit as plain data: no vtable, trivially copyable, so predicted and simulated states are
+//! cheap to copy in bulk. Geometry helpers give the same results as model::Unit.
+struct UnitState
+{
+	double m_x;
+	double m_y;
+	double m_speedX;
+	double m_speedY;
+	double m_angle;
+	double m_angularSpeed;
+	double m_radius;
+
+	static UnitState from(const model::Unit& unit)
+	{
+		const UnitState s = {unit.getX(), unit.getY(), unit.getSpeedX(), unit.getSpeedY(), unit.getAngle(), unit.getAngularSpeed(), unit.getRadius()};
+		return s;
+	}
+
+	Motion getMotion() const                 { return Motion(m_x, m_y, m_speedX, m_speedY); }
+	void   setMotion(const Motion& motion)   { m_x = motion.m_x; m_y = motion.m_y; m_speedX = motion.m_speedX; m_speedY = motion.m_speedY; }
+
+	double getAngleTo(double x, double y) const;
+	double getAngleTo(const model::Unit& unit) const     { return getAngleTo(unit.getX(), unit.getY()); }
+	double getDistanceTo(double x, double y) const;
+	double getDistanceTo(const model::Unit& unit) const  { return getDistanceTo(unit.getX(), unit.getY()); }
+};
+
+static_assert(std::is_trivially_copyable<UnitState>::value && std::is_standard_layout<UnitState>::value, "UnitState must stay plain data");
+
+//! Closed form of free movement as the game integrates it each tick: speed += acceleration; position += speed;
+//! speed *= friction. No walls, no collisions, no speed limit.
+namespace Physics
+{
+	//! sum of friction^k for k in [0, ticks)
+	double getFrictionSum(double friction, unsigned ticks);
+
+	//! after ticks of constant acceleration (ax, ay) per tick
+	Motion predict(const Motion& from, double ax, double ay, double friction, unsigned ticks);
+
+	//! after ticks of sliding without acceleration
+	inline Motion predict(const Motion& from, double friction, unsigned ticks) { return predict(from, 0, 0, friction, ticks); }
+}
+
+#endif
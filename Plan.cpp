@@ -0,0 +1,88 @@
+#include "Plan.h"
+
+using namespace model;
+
+Plan::Plan()
+	: m_action(nullptr)
+	, m_situation()
+	, m_expireTick(-1)
+	, m_isOwnerChanged(false)
+	, m_hasTarget(false)
+	, m_hasPath(false)
+	, m_pathIndex(0)
+{
+}
+
+void Plan::start(TActionPtr action, const Situation& situation, int tick, int lifetime)
+{
+	*this = Plan();
+
+	m_action     = action;
+	m_situation  = situation;
+	m_expireTick = tick + lifetime;
+}
+
+Plan::Validity Plan::check(const Hockeyist& self, const World& world, const Situation& situation) const
+{
+	if (!m_action)
+		return eEMPTY;
+
+	if (m_isOwnerChanged || m_situation != situation)
+		return eSITUATION_CHANGED;
+
+	if (world.getTick() >= m_expireTick)
+		return eEXPIRED;
+
+	const Point* waypoint = getWaypoint();
+	if (!waypoint)
+		return eVALID;
+
+	// is anybody skating across our way?
+	const double dx     = waypoint->x - self.getX();
+	const double dy     = waypoint->y - self.getY();
+	const double length = toVectorSpeed(dx, dy);
+	if (length < 1)
+		return eVALID;
+
+	for (const Hockeyist& h: world.getHockeyists())
+	{
+		if (h.isTeammate() || h.getState() == RESTING || h.getState() == KNOCKED_DOWN)
+			continue;
+
+		const double along  = ((h.getX() - self.getX()) * dx + (h.getY() - self.getY()) * dy) / length;
+		const double across = std::abs((h.getY() - self.getY()) * dx - (h.getX() - self.getX()) * dy) / length;
+		if (along > 0 && along < length && across < h.getRadius() + self.getRadius())
+			return eCORRIDOR_BLOCKED;
+	}
+
+	return eVALID;
+}
+
+void Plan::setTarget(const Point& target, const Point& aim)
+{
+	m_hasTarget = true;
+	m_target    = target;
+	m_aim       = aim;
+}
+
+void Plan::setPath(const PathPlanner::Path& path)
+{
+	m_hasPath   = true;
+	m_path      = path;
+	m_pathIndex = 0;
+}
+
+const Point& Plan::nextWaypoint(const Hockeyist& self)
+{
+	while (m_hasPath && m_pathIndex + 1 < m_path.m_size)
+	{
+		const Point& waypoint = m_path.m_points[m_pathIndex];
+		if (self.getDistanceTo(waypoint.x, waypoint.y) > self.getRadius())
+			break;
+
+		++m_pathIndex;
+	}
+
+	const Point* waypoint = getWaypoint();
+	return waypoint ? *waypoint : m_target;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#ifndef _PLAN_H_
+#define _PLAN_H_
+
+#include "Utils.h"
+#include "PathPlanner.h"
+#include "model/World.h"
+
+class MyStrategy;
+
+//! Per-hockeyist decision kept across ticks: strategy action, target pose and path to it. Replanned only when broken.
+class Plan
+{
+public:
+	typedef void (MyStrategy::* TActionPtr)();
+	typedef long long           TId;
+
+	enum Validity
+	{
+		eVALID = 0,
+		eEMPTY,
+		eSITUATION_CHANGED,
+		eEXPIRED,
+		eCORRIDOR_BLOCKED,
+	};
+
+	//! game situation the plan was made for, any change means replan; puck owner changes come through onPuckOwnerChanged()
+	struct Situation
+	{
+		TId  m_initialDefenderId;
+		bool m_isRestTime;
+		bool m_isFirstCatch;
+
+		Situation(TId defender = -1, bool isRest = false, bool isFirstCatch = false)
+			: m_initialDefenderId(defender), m_isRestTime(isRest), m_isFirstCatch(isFirstCatch)
+		{}
+
+		bool operator==(const Situation& s) const
+		{
+			return m_initialDefenderId == s.m_initialDefenderId && m_isRestTime == s.m_isRestTime && m_isFirstCatch == s.m_isFirstCatch;
+		}
+		bool operator!=(const Situation& s) const { return !(*this == s); }
+	};
+
+private:
+	TActionPtr        m_action;
+	Situation         m_situation;
+	int               m_expireTick;
+	bool              m_isOwnerChanged; //!< puck changed hands since start()
+
+	bool              m_hasTarget;
+	Point             m_target;         //!< where to go
+	Point             m_aim;            //!< where to look at from target
+
+	bool              m_hasPath;
+	PathPlanner::Path m_path;
+	int               m_pathIndex;      //!< current waypoint
+
+	const Point* getWaypoint() const { return m_hasPath && m_pathIndex < m_path.m_size ? &m_path.m_points[m_pathIndex] : nullptr; }
+
+public:
+	Plan();
+
+	void start(TActionPtr action, const Situation& situation, int tick, int lifetime);
+
+	//! situation is unchanged, plan is not expired and no opponent has entered the corridor to the next waypoint
+	Validity check(const model::Hockeyist& self, const model::World& world, const Situation& situation) const;
+
+	//! the plan was made for the previous owner, next check() asks for a new one
+	void onPuckOwnerChanged() { m_isOwnerChanged = true; }
+
+	TActionPtr getAction() const { return m_action; }
+
+	bool         hasTarget() const  { return m_hasTarget; }
+	const Point& getTarget() const  { return m_target; }
+	const Point& getAim()    const  { return m_aim; }
+	void         setTarget(const Point& target, const Point& aim);
+
+	bool hasPath() const { return m_hasPath; }
+	void setPath(const PathPlanner::Path& path);
+
+	//! next waypoint on the way to target, skipping already reached ones; target itself if no path is set
+	const Point& nextWaypoint(const model::Hockeyist& self);
+};
+
+#endif
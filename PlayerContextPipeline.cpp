@@ -0,0 +1,85 @@
+#include "PlayerContextPipeline.h"
+
+#include "AllocationTracker.h"
+#include "Realtime.h"
+
+using namespace model;
+using namespace std;
+
+PlayerContextPipeline::PlayerContextPipeline(RemoteProcessClient& client)
+        : client(client), readIndex(0), count(0), isLent(false), isFinished(false), isStopping(false) {
+    thread = std::thread(&PlayerContextPipeline::decodeLoop, this);
+}
+
+void PlayerContextPipeline::decodeLoop() {
+    Realtime::enterWorkerThread();
+    ALLOCATION_SCOPE(eDECODE, false);
+
+    for (int writeIndex = 0; ; writeIndex ^= 1) {
+        // the server sends one frame per moves message, so the tick thread is at most one frame behind
+        {
+            unique_lock<std::mutex> lock(mutex);
+            slotChanged.wait(lock, [this]() { return count + (isLent ? 1 : 0) < 2 || isStopping; });
+            if (isStopping) {
+                return;
+            }
+        }
+
+        // neither decoded nor lent, so only this thread touches the slot until it's counted
+        bool isDecoded = false;
+        try {
+            isDecoded = client.readPlayerContextMessage(slots[writeIndex]);
+        } catch (const RemoteProcessClient::Stopped&) {
+            // stop() cut the read short, the rest of the message is never coming
+        }
+
+        lock_guard<std::mutex> lock(mutex);
+        if (!isDecoded || isStopping) {
+            isFinished = true;
+            slotChanged.notify_all();
+            return;
+        }
+
+        ++count;
+        slotChanged.notify_all();
+    }
+}
+
+const PlayerContext* PlayerContextPipeline::next() {
+    unique_lock<std::mutex> lock(mutex);
+    // the tick thread is done with the context it got last time
+    isLent = false;
+    slotChanged.notify_all();
+
+    slotChanged.wait(lock, [this]() { return count > 0 || isFinished; });
+    if (count == 0) {
+        return NULL;
+    }
+
+    const PlayerContext* playerContext = &slots[readIndex];
+    readIndex ^= 1;
+    --count;
+    isLent = true;
+    return playerContext;
+}
+
+void PlayerContextPipeline::stop() {
+    bool isReading;
+    {
+        lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+        isReading = !isFinished;
+        slotChanged.notify_all();
+    }
+
+    if (isReading) {
+        client.stop();
+    }
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+PlayerContextPipeline::~PlayerContextPipeline() {
+    stop();
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#ifndef _PLAYER_CONTEXT_PIPELINE_H_
+#define _PLAYER_CONTEXT_PIPELINE_H_
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "RemoteProcessClient.h"
+
+// Decodes PLAYER_CONTEXT messages on a dedicated thread as soon as their bytes arrive, so parsing is off the
+// tick thread's critical path. Two preallocated slots: the one the strategy works on and the next one being decoded
+// in place; they swap owners in next(), nothing is allocated per frame.
+// The client is shared, the tick thread keeps writing moves to it; its transport must allow send() and
+// receive() from different threads (ReceiveAheadTransport does) and wake the decoder with interrupt().
+class PlayerContextPipeline {
+private:
+    RemoteProcessClient& client;
+
+    std::mutex mutex;
+    std::condition_variable slotChanged;
+    model::PlayerContext slots[2];
+    int readIndex; // next slot handed to the tick thread
+    int count; // decoded and not yet taken
+    bool isLent; // the slot before readIndex is still used by the tick thread
+    bool isFinished; // GAME_OVER decoded or decoder stopped, nothing after it
+    bool isStopping; // stop() called, the decoder leaves at its next wait or read
+    std::thread thread;
+
+    void decodeLoop();
+public:
+    // Starts decoding right away, call after the game context is read.
+    explicit PlayerContextPipeline(RemoteProcessClient& client);
+
+    // Next decoded context, waits for it if needed; NULL after GAME_OVER. The pipeline owns it, it stays valid
+    // until the next call, which hands the slot back to the decoder.
+    const model::PlayerContext* next();
+
+    // Ends decoding before the game is over: wakes the decoder wherever it waits, interrupting the client's
+    // transport if it's in a read, and joins it. Contexts not taken yet are dropped. The transport stays open.
+    void stop();
+
+    ~PlayerContextPipeline();
+};
+
+#endif
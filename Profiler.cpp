@@ -0,0 +1,222 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#	include <intrin.h>
+#	define PROFILER_HAS_RDTSC
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#	include <x86intrin.h>
+#	define PROFILER_HAS_RDTSC
+#endif
+
+#ifdef _MSC_VER
+#	define PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+#	define PROFILER_THREAD_LOCAL __thread
+#endif
+
+namespace
+{
+	typedef std::chrono::steady_clock TClock;
+
+	//! written by single owner thread, read by dump() after release of m_written
+	struct ThreadProfile
+	{
+		Profiler::TickRecord               m_current;
+		std::vector<Profiler::TickRecord>  m_ring;
+		std::atomic<unsigned>              m_written;
+		int                                m_index;
+
+		explicit ThreadProfile(int index) : m_ring(Profiler::kRING_TICKS), m_written(0), m_index(index)
+		{
+			std::memset(&m_current, 0, sizeof(m_current));
+		}
+	};
+
+	//! names and thread list change only on registration, never per tick;
+	//! owns the thread profiles, so they outlive their threads until dump() and are freed at exit
+	struct Registry
+	{
+		std::mutex                                  m_mutex;
+		const char*                                 m_zones[Profiler::kMAX_ZONES];
+		const char*                                 m_counters[Profiler::kMAX_COUNTERS];
+		int                                         m_zoneCount;
+		int                                         m_counterCount;
+		std::vector<std::unique_ptr<ThreadProfile>> m_threads;
+		TClock::time_point                          m_startTime;
+		Profiler::TCycles                           m_startCycles;
+
+		Registry() : m_zoneCount(0), m_counterCount(0), m_startTime(TClock::now()), m_startCycles(Profiler::now()) {}
+
+		static Registry& get()
+		{
+			static Registry s_registry;
+			return s_registry;
+		}
+	};
+
+	PROFILER_THREAD_LOCAL ThreadProfile* t_profile = nullptr;
+
+	ThreadProfile& getThreadProfile()
+	{
+		if (!t_profile)
+		{
+			Registry& r = Registry::get();
+			std::lock_guard<std::mutex> lock(r.m_mutex);
+			r.m_threads.emplace_back(new ThreadProfile(static_cast<int>(r.m_threads.size())));
+			t_profile = r.m_threads.back().get();
+		}
+		return *t_profile;
+	}
+
+	int registerName(const char* name, const char** names, int& count, int capacity)
+	{
+		Registry& r = Registry::get();
+		std::lock_guard<std::mutex> lock(r.m_mutex);
+
+		for (int i = 0; i < count; ++i)
+		{
+			if (std::strcmp(names[i], name) == 0)
+				return i;
+		}
+
+		// overflow shares the last slot rather than writing out of bounds
+		if (count == capacity)
+			return capacity - 1;
+
+		names[count] = name;
+		return count++;
+	}
+
+	double getPercentile(std::vector<double>& values, double fraction)
+	{
+		if (values.empty())
+			return 0;
+
+		const size_t n = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+		std::nth_element(values.begin(), values.begin() + n, values.end());
+		return values[n];
+	}
+}
+
+int Profiler::registerZone(const char* name)
+{
+	Registry& r = Registry::get();
+	return registerName(name, r.m_zones, r.m_zoneCount, kMAX_ZONES);
+}
+
+int Profiler::registerCounter(const char* name)
+{
+	Registry& r = Registry::get();
+	return registerName(name, r.m_counters, r.m_counterCount, kMAX_COUNTERS);
+}
+
+Profiler::TCycles Profiler::now()
+{
+#ifdef PROFILER_HAS_RDTSC
+	return __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(TClock::now().time_since_epoch()).count();
+#endif
+}
+
+Profiler::TickRecord& Profiler::getCurrent()
+{
+	return getThreadProfile().m_current;
+}
+
+void Profiler::count(int counter, unsigned long long n)
+{
+	getThreadProfile().m_current.m_counters[counter] += n;
+}
+
+void Profiler::endTick(int tick)
+{
+	ThreadProfile& p       = getThreadProfile();
+	const unsigned written = p.m_written.load(std::memory_order_relaxed);
+
+	p.m_current.m_tick = tick;
+	p.m_ring[written % kRING_TICKS] = p.m_current;
+	p.m_written.store(written + 1, std::memory_order_release);
+
+	std::memset(&p.m_current, 0, sizeof(p.m_current));
+}
+
+bool Profiler::dump(const std::string& path)
+{
+	FILE* file = std::fopen(path.c_str(), "w");
+	if (!file)
+		return false;
+
+	Registry& r = Registry::get();
+	std::lock_guard<std::mutex> lock(r.m_mutex);
+
+	// cycles to nanoseconds from the whole run, so no calibration stall at startup
+	const double elapsedNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(TClock::now() - r.m_startTime).count());
+	const double cycles    = static_cast<double>(now() - r.m_startCycles);
+	const double nsPerCycle = cycles > 0 ? elapsedNs / cycles : 1.0;
+
+	for (const std::unique_ptr<ThreadProfile>& p: r.m_threads)
+	{
+		const unsigned written = p->m_written.load(std::memory_order_acquire);
+		const unsigned count   = std::min<unsigned>(written, kRING_TICKS);
+		const unsigned first   = written - count;
+
+		std::fprintf(file, "# thread %d, %u ticks\n", p->m_index, count);
+		std::fprintf(file, "zone,calls,mean_us,p50_us,p99_us,max_us\n");
+		for (int z = 0; z < r.m_zoneCount; ++z)
+		{
+			std::vector<double> perTick;
+			unsigned long long  calls = 0;
+			double              total = 0;
+			for (unsigned i = first; i < written; ++i)
+			{
+				const TickRecord& t = p->m_ring[i % kRING_TICKS];
+				if (!t.m_calls[z])
+					continue;
+
+				perTick.push_back(t.m_cycles[z] * nsPerCycle / 1000.0);
+				calls += t.m_calls[z];
+				total += perTick.back();
+			}
+
+			if (perTick.empty())
+				continue;
+
+			const double mean = total / perTick.size();
+			const double p50  = getPercentile(perTick, 0.5);
+			const double p99  = getPercentile(perTick, 0.99);
+			const double max  = *std::max_element(perTick.begin(), perTick.end());
+			std::fprintf(file, "%s,%llu,%.2f,%.2f,%.2f,%.2f\n", r.m_zones[z], calls, mean, p50, p99, max);
+		}
+
+		std::fprintf(file, "tick");
+		for (int z = 0; z < r.m_zoneCount; ++z)
+			std::fprintf(file, ",%s_us,%s_calls", r.m_zones[z], r.m_zones[z]);
+		for (int c = 0; c < r.m_counterCount; ++c)
+			std::fprintf(file, ",%s", r.m_counters[c]);
+		std::fprintf(file, "\n");
+
+		for (unsigned i = first; i < written; ++i)
+		{
+			const TickRecord& t = p->m_ring[i % kRING_TICKS];
+			std::fprintf(file, "%d", t.m_tick);
+			for (int z = 0; z < r.m_zoneCount; ++z)
+				std::fprintf(file, ",%.2f,%u", t.m_cycles[z] * nsPerCycle / 1000.0, t.m_calls[z]);
+			for (int c = 0; c < r.m_counterCount; ++c)
+				std::fprintf(file, ",%llu", t.m_counters[c]);
+			std::fprintf(file, "\n");
+		}
+	}
+
+	std::fclose(file);
+	return true;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+#include <string>
+
+//! Per-tick scoped timers and counters. Each thread writes its own ring of tick records without locks; all rings are dumped at game end.
+//! Compiled in with USE_PROFILER, otherwise PROFILE_* macros are empty.
+class Profiler
+{
+public:
+	typedef unsigned long long TCycles;
+
+	static const int kMAX_ZONES    = 32;
+	static const int kMAX_COUNTERS = 16;
+	static const int kRING_TICKS   = 8192;   //!< whole game with overtime fits
+
+	struct TickRecord
+	{
+		int                m_tick;
+		TCycles            m_cycles[kMAX_ZONES];
+		unsigned           m_calls[kMAX_ZONES];
+		unsigned long long m_counters[kMAX_COUNTERS];
+	};
+
+	//! thread record is fetched before the clock starts, so its first-time allocation isn't timed
+	class ScopedTimer
+	{
+		TickRecord& m_record;
+		int         m_zone;
+		TCycles     m_start;
+
+	public:
+		explicit ScopedTimer(int zone) : m_record(getCurrent()), m_zone(zone), m_start(now()) {}
+		~ScopedTimer()
+		{
+			m_record.m_cycles[m_zone] += now() - m_start;
+			++m_record.m_calls[m_zone];
+		}
+	};
+
+	//! called once per call site (function-local static), thread safe
+	static int registerZone(const char* name);
+	static int registerCounter(const char* name);
+
+	//! rdtsc on x86, steady clock nanoseconds elsewhere
+	static TCycles now();
+
+	//! accumulators of the calling thread for the current tick
+	static TickRecord& getCurrent();
+
+	static void count(int counter, unsigned long long n);
+
+	//! commit current thread accumulators as tick record
+	static void endTick(int tick);
+
+	//! per-thread tick table and per-zone summary in CSV-like text
+	static bool dump(const std::string& path);
+};
+
+#ifdef USE_PROFILER
+#	define PROFILE_CONCAT_(a, b)  a##b
+#	define PROFILE_CONCAT(a, b)   PROFILE_CONCAT_(a, b)
+#	define PROFILE_SCOPE(name) \
+		static const int PROFILE_CONCAT(profileZone, __LINE__) = Profiler::registerZone(name); \
+		Profiler::ScopedTimer PROFILE_CONCAT(profileTimer, __LINE__)(PROFILE_CONCAT(profileZone, __LINE__))
+#	define PROFILE_COUNT(name, n) \
+		do { static const int profileCounter = Profiler::registerCounter(name); Profiler::count(profileCounter, (n)); } while (false)
+#	define PROFILE_END_TICK(tick) Profiler::endTick(tick)
+#else
+#	define PROFILE_SCOPE(name)
+#	define PROFILE_COUNT(name, n)
+#	define PROFILE_END_TICK(tick)
+#endif
+
+#endif
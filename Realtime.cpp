@@ -0,0 +1,124 @@
+#include "Realtime.h"
+
+#include <cstdlib>
+
+#ifdef _LINUX
+#include <alloca.h>
+#include <cstring>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+
+namespace {
+    vector<int> workerCpus;
+    int workerPriority = 0;
+
+#ifdef _LINUX
+    // separate frame, so the touched region is below the caller's stack
+    __attribute__((noinline)) void prefaultStack(size_t byteCount) {
+        volatile char* stack = (volatile char*) alloca(byteCount);
+        for (size_t offset = 0; offset < byteCount; offset += 4096) {
+            stack[offset] = 0;
+        }
+    }
+#endif
+}
+
+bool Realtime::parseCpuList(const string& text, vector<int>& cpus) {
+    cpus.clear();
+    size_t position = 0;
+    while (position < text.size()) {
+        size_t end = text.find(',', position);
+        if (end == string::npos) {
+            end = text.size();
+        }
+
+        const string range = text.substr(position, end - position);
+        char* rest;
+        long first = strtol(range.c_str(), &rest, 10);
+        long last = first;
+        if (*rest == '-') {
+            last = strtol(rest + 1, &rest, 10);
+        }
+        if (range.empty() || *rest != '\0' || first < 0 || last < first || last >= 1024) {
+            return false;
+        }
+
+        for (long cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back((int) cpu);
+        }
+        position = end + 1;
+    }
+
+    return !cpus.empty();
+}
+
+#ifdef _LINUX
+
+bool Realtime::pinCurrentThread(const vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu: cpus) {
+        CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+bool Realtime::setCurrentThreadFifo(int priority) {
+    sched_param parameter = sched_param();
+    parameter.sched_priority = priority;
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameter) == 0;
+}
+
+bool Realtime::lockMemory(size_t stackBytes, size_t heapBytes) {
+    // freed memory stays in the heap, large blocks too, instead of going back to the kernel
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+
+    bool isLocked = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+
+    prefaultStack(stackBytes);
+    if (heapBytes > 0) {
+        void* heap = malloc(heapBytes);
+        if (heap != NULL) {
+            memset(heap, 0, heapBytes);
+            free(heap);
+        }
+    }
+
+    return isLocked;
+}
+
+#else
+
+bool Realtime::pinCurrentThread(const vector<int>&) {
+    return false;
+}
+
+bool Realtime::setCurrentThreadFifo(int) {
+    return false;
+}
+
+bool Realtime::lockMemory(size_t, size_t) {
+    return false;
+}
+
+#endif
+
+void Realtime::setWorkerPolicy(const vector<int>& cpus, int priority) {
+    workerCpus = cpus;
+    workerPriority = priority;
+}
+
+void Realtime::enterWorkerThread() {
+    if (!workerCpus.empty()) {
+        pinCurrentThread(workerCpus);
+    }
+    if (workerPriority > 0) {
+        setCurrentThreadFifo(workerPriority);
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#ifndef _REALTIME_H_
+#define _REALTIME_H_
+
+#include <string>
+#include <vector>
+
+// Process placement for latency runs on shared hosts: CPU pinning, SCHED_FIFO, locked and pre-faulted memory.
+// Linux only, elsewhere every call fails. Failures (no CAP_SYS_NICE, RLIMIT_MEMLOCK too low) are reported by
+// the return value, the game goes on either way.
+namespace Realtime {
+    // "2", "2,3" or "4-7,9".
+    bool parseCpuList(const std::string& text, std::vector<int>& cpus);
+
+    // Current thread only; threads started afterwards inherit both.
+    bool pinCurrentThread(const std::vector<int>& cpus);
+    bool setCurrentThreadFifo(int priority);
+
+    // mlockall() of current and future mappings, then touches stackBytes of stack and heapBytes of heap, which
+    // malloc is told to keep instead of trimming, so the game runs without page faults.
+    bool lockMemory(size_t stackBytes, size_t heapBytes);
+
+    // Placement of worker threads (socket reader, context decoder), set before they start: CPUs, empty to
+    // inherit, and SCHED_FIFO priority, 0 to inherit.
+    void setWorkerPolicy(const std::vector<int>& cpus, int priority);
+
+    // Called first thing by each worker thread.
+    void enterWorkerThread();
+}
+
+#endif
@@ -0,0 +1,166 @@
+#include "ReceiveAheadTransport.h"
+
+#ifdef _LINUX
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Realtime.h"
+
+using namespace std;
+
+namespace {
+    // 1 MiB, hundreds of ticks; the server never sends more than one tick ahead anyway
+    const size_t QUEUE_CAPACITY_LOG2 = 20;
+}
+
+ReceiveAheadTransport::ReceiveAheadTransport(unique_ptr<SocketTransport> transport)
+        : transport(std::move(transport)), descriptor(this->transport->getSocket().GetSocketDescriptor()),
+          epollDescriptor(epoll_create1(EPOLL_CLOEXEC)), stopDescriptor(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)),
+          queue(QUEUE_CAPACITY_LOG2), isInputEnd(false), isConsumerWaiting(false) {
+    if (!this->transport->getSocket().SetNonblocking() || epollDescriptor < 0 || stopDescriptor < 0) {
+        exit(10015);
+    }
+
+    epoll_event socketEvent = epoll_event();
+    socketEvent.events = EPOLLIN | EPOLLRDHUP;
+    socketEvent.data.fd = descriptor;
+    epoll_event stopEvent = epoll_event();
+    stopEvent.events = EPOLLIN;
+    stopEvent.data.fd = stopDescriptor;
+    if (epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, descriptor, &socketEvent) != 0
+            || epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, stopDescriptor, &stopEvent) != 0) {
+        exit(10015);
+    }
+
+    thread = std::thread(&ReceiveAheadTransport::readLoop, this);
+}
+
+void ReceiveAheadTransport::readLoop() {
+    Realtime::enterWorkerThread();
+
+    epoll_event events[2];
+    bool isStopped = false;
+
+    while (!isStopped && !isInputEnd.load()) {
+        int eventCount = epoll_wait(epollDescriptor, events, 2, -1);
+        if (eventCount < 0 && errno != EINTR) {
+            break;
+        }
+
+        for (int eventIndex = 0; eventIndex < eventCount; ++eventIndex) {
+            if (events[eventIndex].data.fd == stopDescriptor) {
+                isStopped = true;
+            }
+        }
+
+        // drain the socket, level-triggered epoll comes back if the queue is full
+        for (;;) {
+            size_t freeByteCount;
+            signed char* free = queue.getWritable(freeByteCount);
+            if (freeByteCount == 0) {
+                std::this_thread::yield();
+                break;
+            }
+
+            ssize_t receivedByteCount = recv(descriptor, free, freeByteCount, 0);
+            if (receivedByteCount > 0) {
+                queue.commit((size_t) receivedByteCount);
+                wakeConsumer();
+                continue;
+            }
+
+            if (receivedByteCount < 0 && errno == EINTR) {
+                continue;
+            }
+            if (receivedByteCount == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                isInputEnd.store(true);
+                wakeConsumer();
+            }
+            break;
+        }
+    }
+
+    isInputEnd.store(true);
+    wakeConsumer();
+}
+
+void ReceiveAheadTransport::wakeConsumer() {
+    // seq_cst pairs with the consumer setting the flag before checking the queue, no wake-up is lost
+    if (isConsumerWaiting.load()) {
+        lock_guard<std::mutex> lock(mutex);
+        dataReady.notify_one();
+    }
+}
+
+int ReceiveAheadTransport::receive(void* buffer, int byteCount) {
+    size_t readByteCount = queue.read(buffer, (size_t) byteCount);
+    if (readByteCount > 0) {
+        return (int) readByteCount;
+    }
+
+    unique_lock<std::mutex> lock(mutex);
+    isConsumerWaiting.store(true);
+    dataReady.wait(lock, [this]() { return queue.getReadable() > 0 || isInputEnd.load(); });
+    isConsumerWaiting.store(false);
+    lock.unlock();
+
+    // bytes received before the end of stream are still delivered
+    return (int) queue.read(buffer, (size_t) byteCount);
+}
+
+int ReceiveAheadTransport::send(const void* data, int byteCount) {
+    for (;;) {
+        ssize_t sentByteCount = ::send(descriptor, data, (size_t) byteCount, MSG_NOSIGNAL);
+        if (sentByteCount >= 0) {
+            return (int) sentByteCount;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            return -1;
+        }
+
+        // socket buffer full, only happens if the server stops reading
+        pollfd writable = {descriptor, POLLOUT, 0};
+        poll(&writable, 1, -1);
+    }
+}
+
+void ReceiveAheadTransport::interrupt() {
+    // the I/O thread sets isInputEnd and wakes the consumer on its way out
+    uint64_t one = 1;
+    if (stopDescriptor >= 0 && write(stopDescriptor, &one, sizeof(one)) < 0) {
+        // counter overflow only, the thread is being woken anyway
+    }
+}
+
+void ReceiveAheadTransport::close() {
+    if (thread.joinable()) {
+        interrupt();
+        thread.join();
+    }
+
+    if (epollDescriptor >= 0) {
+        ::close(epollDescriptor);
+        epollDescriptor = -1;
+    }
+    if (stopDescriptor >= 0) {
+        ::close(stopDescriptor);
+        stopDescriptor = -1;
+    }
+    transport->close();
+}
+
+ReceiveAheadTransport::~ReceiveAheadTransport() {
+    this->close();
+}
+
+#endif
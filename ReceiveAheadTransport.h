@@ -0,0 +1,49 @@
+#pragma once
+
+#ifndef _RECEIVE_AHEAD_TRANSPORT_H_
+#define _RECEIVE_AHEAD_TRANSPORT_H_
+
+#ifdef _LINUX
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "ByteQueue.h"
+#include "Transport.h"
+
+// Socket read by a dedicated I/O thread: non-blocking recv() driven by epoll into a ByteQueue, so bytes of
+// the next tick are in user space by the time the strategy asks for them. Sends go straight to the socket.
+class ReceiveAheadTransport : public Transport {
+private:
+    std::unique_ptr<SocketTransport> transport;
+    int descriptor;
+    int epollDescriptor;
+    int stopDescriptor; // eventfd waking the I/O thread on close
+    ByteQueue queue;
+
+    std::atomic<bool> isInputEnd; // end of stream or error, set by I/O thread
+    std::atomic<bool> isConsumerWaiting;
+    std::mutex mutex;
+    std::condition_variable dataReady;
+    std::thread thread;
+
+    void readLoop();
+    void wakeConsumer();
+public:
+    explicit ReceiveAheadTransport(std::unique_ptr<SocketTransport> transport);
+
+    int receive(void* buffer, int byteCount);
+    int send(const void* data, int byteCount);
+    // Stops the I/O thread, receive() delivers what is queued and then returns 0.
+    void interrupt();
+    void close();
+
+    ~ReceiveAheadTransport();
+};
+
+#endif
+
+#endif
@@ -11,13 +11,11 @@ const int INTEGER_SIZE_BYTES = sizeof(int);
 const int LONG_SIZE_BYTES = sizeof(long long);
 
 RemoteProcessClient::RemoteProcessClient(string host, int port)
-        : cachedBoolFlag(false), cachedBoolValue(false) {
-    socket.Initialize();
-    socket.DisableNagleAlgoritm();
+        : transport(new SocketTransport(host, port)), cachedBoolFlag(false), cachedBoolValue(false), isStopped(false) {
+}
 
-    if (!socket.Open((uint8*) host.c_str(), (int16) port)) {
-        exit(10001);
-    }
+RemoteProcessClient::RemoteProcessClient(unique_ptr<Transport> transport)
+        : transport(std::move(transport)), cachedBoolFlag(false), cachedBoolValue(false), isStopped(false) {
 }
 
 void RemoteProcessClient::writeTokenMessage(const string& token) {
@@ -27,7 +25,11 @@ void RemoteProcessClient::writeTokenMessage(const string& token) {
 
 int RemoteProcessClient::readTeamSizeMessage() {
     ensureMessageType((MessageType) readEnum(), TEAM_SIZE);
-    return readInt();
+    int teamSize = readInt();
+    if (teamSize < 0 || teamSize > (int) Moves::capacity()) {
+        exit(10016);
+    }
+    return teamSize;
 }
 
 void RemoteProcessClient::writeProtocolVersionMessage() {
@@ -41,32 +43,93 @@ Game RemoteProcessClient::readGameContextMessage() {
 }
 
 PlayerContext* RemoteProcessClient::readPlayerContextMessage() {
+    return readPlayerContextMessageType() ? readPlayerContextMessageBody() : NULL;
+}
+
+bool RemoteProcessClient::readPlayerContextMessageType() {
     MessageType messageType = (MessageType) readEnum();
     if (messageType == GAME_OVER) {
-        return NULL;
+        return false;
     }
 
     ensureMessageType(messageType, PLAYER_CONTEXT);
+    return true;
+}
+
+PlayerContext* RemoteProcessClient::readPlayerContextMessageBody() {
+    // parsed before it's owned by anybody, a Stopped read must not leak it
+    PlayerContext playerContext;
+    return readPlayerContextMessageBody(playerContext) ? new PlayerContext(playerContext) : NULL;
+}
+
+bool RemoteProcessClient::readPlayerContextMessage(PlayerContext& playerContext) {
+    return readPlayerContextMessageType() && readPlayerContextMessageBody(playerContext);
+}
 
+bool RemoteProcessClient::readPlayerContextMessageBody(PlayerContext& playerContext) {
     if (!readBoolean()) {
-        return NULL;
+        return false;
     }
 
     cachedBoolFlag = true;
     cachedBoolValue = true;
 
-    PlayerContext* playerContext = new PlayerContext;
-    *playerContext = readPlayerContext();
-    return playerContext;
+    playerContext = readPlayerContext();
+    return true;
 }
 
-void RemoteProcessClient::writeMovesMessage(const vector<Move>& moves) {
+void RemoteProcessClient::writeMovesMessage(const Moves& moves) {
     writeEnum(MOVES_MESSAGE);
     writeMoves(moves);
 }
 
+string RemoteProcessClient::readTokenMessage() {
+    ensureMessageType((MessageType) readEnum(), AUTHENTICATION_TOKEN);
+    return readString();
+}
+
+void RemoteProcessClient::writeTeamSizeMessage(int teamSize) {
+    writeEnum(TEAM_SIZE);
+    writeInt(teamSize);
+}
+
+int RemoteProcessClient::readProtocolVersionMessage() {
+    ensureMessageType((MessageType) readEnum(), PROTOCOL_VERSION);
+    return readInt();
+}
+
+void RemoteProcessClient::writeGameContextMessage(const Game& game) {
+    writeEnum(GAME_CONTEXT);
+    writeGame(game);
+}
+
+void RemoteProcessClient::writePlayerContextMessage(const PlayerContext& playerContext) {
+    writeEnum(PLAYER_CONTEXT);
+    writePlayerContext(playerContext);
+}
+
+void RemoteProcessClient::writeGameOverMessage() {
+    writeEnum(GAME_OVER);
+}
+
+bool RemoteProcessClient::readMovesMessage(Moves& moves) {
+    MessageType messageType = (MessageType) readEnum();
+    if (messageType == GAME_OVER) {
+        return false;
+    }
+
+    ensureMessageType(messageType, MOVES_MESSAGE);
+    moves = readMoves();
+    return true;
+}
+
+void RemoteProcessClient::stop() {
+    isStopped.store(true);
+    transport->interrupt();
+}
+
 void RemoteProcessClient::close() {
-    socket.Close();
+    transport->close();
 }
 
 Game RemoteProcessClient::readGame() {
@@ -335,14 +398,13 @@ void RemoteProcessClient::writeHockeyist(const Hockeyist& hockeyist) {
     }
 }
 
-vector<Hockeyist> RemoteProcessClient::readHockeyists() {
+Hockeyists RemoteProcessClient::readHockeyists() {
     int hockeyistCount = readInt();
-    if (hockeyistCount < 0) {
+    if (hockeyistCount < 0 || hockeyistCount > (int) Hockeyists::capacity()) {
         exit(20004);
     }
 
-    vector<Hockeyist> hockeyists;
-    hockeyists.reserve(hockeyistCount);
+    Hockeyists hockeyists;
 
     for (int hockeyistIndex = 0; hockeyistIndex < hockeyistCount; ++hockeyistIndex) {
         hockeyists.push_back(readHockeyist());
@@ -351,7 +413,7 @@ vector<Hockeyist> RemoteProcessClient::readHockeyists() {
     return hockeyists;
 }
 
-void RemoteProcessClient::writeHockeyists(const vector<Hockeyist>& hockeyists) {
+void RemoteProcessClient::writeHockeyists(const Hockeyists& hockeyists) {
     int hockeyistCount = hockeyists.size();
     writeInt(hockeyistCount);
 
@@ -394,14 +456,13 @@ void RemoteProcessClient::writeMove(const Move& move) {
     }
 }
 
-vector<Move> RemoteProcessClient::readMoves() {
+Moves RemoteProcessClient::readMoves() {
     int moveCount = readInt();
-    if (moveCount < 0) {
+    if (moveCount < 0 || moveCount > (int) Moves::capacity()) {
         exit(20006);
     }
 
-    vector<Move> moves;
-    moves.reserve(moveCount);
+    Moves moves;
 
     for (int moveIndex = 0; moveIndex < moveCount; ++moveIndex) {
         moves.push_back(readMove());
@@ -410,7 +471,7 @@ vector<Move> RemoteProcessClient::readMoves() {
     return moves;
 }
 
-void RemoteProcessClient::writeMoves(const vector<Move>& moves) {
+void RemoteProcessClient::writeMoves(const Moves& moves) {
     int moveCount = moves.size();
     writeInt(moveCount);
 
@@ -460,14 +521,13 @@ void RemoteProcessClient::writePlayer(const Player& player) {
     writeBoolean(player.isJustMissedGoal());
 }
 
-vector<Player> RemoteProcessClient::readPlayers() {
+Players RemoteProcessClient::readPlayers() {
     int playerCount = readInt();
-    if (playerCount < 0) {
+    if (playerCount < 0 || playerCount > (int) Players::capacity()) {
         exit(20008);
     }
 
-    vector<Player> players;
-    players.reserve(playerCount);
+    Players players;
 
     for (int playerIndex = 0; playerIndex < playerCount; ++playerIndex) {
         players.push_back(readPlayer());
@@ -476,7 +536,7 @@ vector<Player> RemoteProcessClient::readPlayers() {
     return players;
 }
 
-void RemoteProcessClient::writePlayers(const vector<Player>& players) {
+void RemoteProcessClient::writePlayers(const Players& players) {
     int playerCount = players.size();
     writeInt(playerCount);
 
@@ -490,7 +550,7 @@ PlayerContext RemoteProcessClient::readPlayerContext() {
         exit(20009);
     }
 
-    std::vector<Hockeyist> hockeyists = readHockeyists();
+    Hockeyists hockeyists = readHockeyists();
     World world = readWorld();
 
     return PlayerContext(hockeyists, world);
@@ -594,8 +654,8 @@ World RemoteProcessClient::readWorld() {
     int tickCount = readInt();
     double width = readDouble();
     double height = readDouble();
-    std::vector<Player> players = readPlayers();
-    std::vector<Hockeyist> hockeyists = readHockeyists();
+    Players players = readPlayers();
+    Hockeyists hockeyists = readHockeyists();
     Puck puck = readPuck();
 
     return World(tick, tickCount, width, height, players, hockeyists, puck);
@@ -753,12 +813,14 @@ vector<signed char> RemoteProcessClient::readBytes(unsigned int byteCount) {
     unsigned int offset = 0;
     int receivedByteCount;
 
-    while (offset < byteCount && (receivedByteCount = socket.Receive(byteCount - offset)) > 0) {
-        memcpy(&bytes[offset], socket.GetData(), receivedByteCount);
+    while (offset < byteCount && (receivedByteCount = transport->receive(&bytes[offset], byteCount - offset)) > 0) {
         offset += receivedByteCount;
     }
 
     if (offset != byteCount) {
+        if (isStopped.load()) {
+            throw Stopped();
+        }
         exit(10012);
     }
 
@@ -770,7 +832,7 @@ void RemoteProcessClient::writeBytes(const vector<signed char>& bytes) {
     unsigned int offset = 0;
     int sentByteCount;
 
-    while (offset < byteCount && (sentByteCount = socket.Send((uint8*) &bytes[offset], byteCount - offset)) > 0) {
+    while (offset < byteCount && (sentByteCount = transport->send(&bytes[offset], byteCount - offset)) > 0) {
         offset += sentByteCount;
     }
 
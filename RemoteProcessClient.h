@@ -3,10 +3,12 @@
 #ifndef _REMOTE_PROCESS_CLIENT_H_
 #define _REMOTE_PROCESS_CLIENT_H_
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
-#include "csimplesocket/ActiveSocket.h"
+#include "Transport.h"
 #include "model/Game.h"
 #include "model/Move.h"
 #include "model/PlayerContext.h"
@@ -25,9 +27,10 @@ enum MessageType {
 
 class RemoteProcessClient {
 private:
-    CActiveSocket socket;
+    std::unique_ptr<Transport> transport;
 	bool cachedBoolFlag;
 	bool cachedBoolValue;
+    std::atomic<bool> isStopped;
 
     model::Game readGame();
     void writeGame(const model::Game& game);
@@ -35,16 +38,16 @@ private:
     void writeGames(const std::vector<model::Game>& games);
     model::Hockeyist readHockeyist();
     void writeHockeyist(const model::Hockeyist& hockeyist);
-    std::vector<model::Hockeyist> readHockeyists();
-    void writeHockeyists(const std::vector<model::Hockeyist>& hockeyists);
+    model::Hockeyists readHockeyists();
+    void writeHockeyists(const model::Hockeyists& hockeyists);
     model::Move readMove();
     void writeMove(const model::Move& move);
-    std::vector<model::Move> readMoves();
-    void writeMoves(const std::vector<model::Move>& moves);
+    model::Moves readMoves();
+    void writeMoves(const model::Moves& moves);
     model::Player readPlayer();
     void writePlayer(const model::Player& player);
-    std::vector<model::Player> readPlayers();
-    void writePlayers(const std::vector<model::Player>& players);
+    model::Players readPlayers();
+    void writePlayers(const model::Players& players);
     model::PlayerContext readPlayerContext();
     void writePlayerContext(const model::PlayerContext& playerContext);
     std::vector<model::PlayerContext> readPlayerContexts();
@@ -77,14 +80,40 @@ private:
 
     static bool isLittleEndianMachine();
 public:
+    // Thrown instead of exit(10012) by a read cut short after stop(), so a reading thread can leave a half-read message.
+    struct Stopped {
+    };
+
     RemoteProcessClient(std::string host, int port);
+    explicit RemoteProcessClient(std::unique_ptr<Transport> transport);
 
     void writeTokenMessage(const std::string& token);
     int readTeamSizeMessage();
     void writeProtocolVersionMessage();
     model::Game readGameContextMessage();
     model::PlayerContext* readPlayerContextMessage();
-    void writeMovesMessage(const std::vector<model::Move>& move);
+    // readPlayerContextMessage() in two steps, so waiting for the server and parsing can be timed apart:
+    // the type blocks until the next message starts, false on GAME_OVER; the body is only read after true.
+    bool readPlayerContextMessageType();
+    model::PlayerContext* readPlayerContextMessageBody();
+    // Same as above without the heap: decodes into an existing context, false instead of NULL.
+    bool readPlayerContextMessage(model::PlayerContext& playerContext);
+    bool readPlayerContextMessageBody(model::PlayerContext& playerContext);
+    void writeMovesMessage(const model::Moves& moves);
+
+    // Game runner side of the protocol, for local peers, replays and benchmarks.
+    std::string readTokenMessage();
+    void writeTeamSizeMessage(int teamSize);
+    int readProtocolVersionMessage();
+    void writeGameContextMessage(const model::Game& game);
+    void writePlayerContextMessage(const model::PlayerContext& playerContext);
+    void writeGameOverMessage();
+    bool readMovesMessage(model::Moves& moves);
+
+    Transport& getTransport() { return *transport; }
+
+    // Wakes a read blocked in another thread, see Transport::interrupt(); writes keep working.
+    void stop();
 
     void close();
 
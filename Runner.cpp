@@ -1,16 +1,48 @@
 #include "Runner.h"
 
+#include <cstdio>
+#include <cstdlib>
 #include <vector>
 
+#include "AllocationTracker.h"
+#include "BusyPollTransport.h"
+#include "LocalTransport.h"
+#include "Log.h"
 #include "MyStrategy.h"
+#include "PlayerContextPipeline.h"
+#include "Profiler.h"
+#include "Realtime.h"
+#include "ReceiveAheadTransport.h"
+#include "TeamContext.h"
 
 using namespace model;
 using namespace std;
 
 int main(int argc, char* argv[]) {
-    if (argc == 4) {
-        Runner runner(argv[1], argv[2], argv[3]);
+    if (argc >= 4) {
+        RunnerOptions options;
+        if (!options.parse(argc - 4, argv + 4)) {
+            fprintf(stderr, "usage: %s host|unix:path|shm:name port token [--record file] [--profile file] [--log file] [--trace file] [--params file] [--receive-ahead] [--pipelined] [--busy-poll us]"
+                    " [--cpu list] [--worker-cpus list] [--fifo priority] [--mlock] [--allocations file] [--no-alloc log|abort]\n", argv[0]);
+            return 1;
+        }
+
+        string error;
+        if (!options.parametersPath.empty() && !options.parameters.load(options.parametersPath, error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+
+        if (!options.logPath.empty() && !Log::start(options.logPath)) {
+            fprintf(stderr, "can't write log %s\n", options.logPath.c_str());
+        }
+
+        // after the log writer started, it keeps default placement
+        options.applyRealtime();
+
+        Runner runner(argv[1], argv[2], argv[3], options);
         runner.run();
+        Log::stop();
     } else {
         Runner runner("127.0.0.1", "31001", "0000000000000000");
         runner.run();
@@ -19,8 +51,143 @@ int main(int argc, char* argv[]) {
     return 0;
 }
 
-Runner::Runner(const char* host, const char* port, const char* token)
-        : remoteProcessClient(host, atoi(port)), token(token) {
+bool RunnerOptions::parse(int argc, char* argv[]) {
+    for (int argIndex = 0; argIndex < argc; ++argIndex) {
+        string arg = argv[argIndex];
+        if (arg == "--record" && argIndex + 1 < argc) {
+            recordPath = argv[++argIndex];
+        } else if (arg == "--profile" && argIndex + 1 < argc) {
+#ifndef USE_PROFILER
+            // the report would be empty
+            fprintf(stderr, "--profile needs a build with PROFILER=ON\n");
+            return false;
+#endif
+            profilePath = argv[++argIndex];
+        } else if (arg == "--log" && argIndex + 1 < argc) {
+            logPath = argv[++argIndex];
+        } else if (arg == "--trace" && argIndex + 1 < argc) {
+            tracePath = argv[++argIndex];
+        } else if (arg == "--params" && argIndex + 1 < argc) {
+            parametersPath = argv[++argIndex];
+        } else if (arg == "--receive-ahead") {
+            isReceiveAhead = true;
+        } else if (arg == "--pipelined") {
+            isReceiveAhead = true;
+            isPipelined = true;
+        } else if (arg == "--busy-poll" && argIndex + 1 < argc) {
+            busyPollMicroseconds = atoi(argv[++argIndex]);
+            if (busyPollMicroseconds < 0) {
+                return false;
+            }
+        } else if (arg == "--cpu" && argIndex + 1 < argc) {
+            if (!Realtime::parseCpuList(argv[++argIndex], tickCpus)) {
+                return false;
+            }
+        } else if (arg == "--worker-cpus" && argIndex + 1 < argc) {
+            if (!Realtime::parseCpuList(argv[++argIndex], workerCpus)) {
+                return false;
+            }
+        } else if (arg == "--fifo" && argIndex + 1 < argc) {
+            fifoPriority = atoi(argv[++argIndex]);
+            if (fifoPriority < 1 || fifoPriority > 99) {
+                return false;
+            }
+        } else if (arg == "--mlock") {
+            isMemoryLocked = true;
+        } else if (arg == "--allocations" && argIndex + 1 < argc) {
+#ifndef USE_ALLOCATION_TRACKING
+            // the report would be empty
+            fprintf(stderr, "--allocations needs a build with ALLOCATION_TRACKING=ON\n");
+            return false;
+#endif
+            allocationsPath = argv[++argIndex];
+        } else if (arg == "--no-alloc" && argIndex + 1 < argc) {
+#ifndef USE_ALLOCATION_TRACKING
+            // nothing would see the allocations
+            fprintf(stderr, "--no-alloc needs a build with ALLOCATION_TRACKING=ON\n");
+            return false;
+#endif
+            string policy = argv[++argIndex];
+            if (policy == "log") {
+                AllocationTracker::setPolicy(AllocationTracker::eLOG);
+            } else if (policy == "abort") {
+                AllocationTracker::setPolicy(AllocationTracker::eABORT);
+            } else {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void RunnerOptions::applyRealtime() const {
+    // stack and heap the strategy is expected to reach, generously
+    const size_t STACK_PREFAULT_BYTES = 512 * 1024;
+    const size_t HEAP_PREFAULT_BYTES = 64 * 1024 * 1024;
+
+    if (!tickCpus.empty() && !Realtime::pinCurrentThread(tickCpus)) {
+        fprintf(stderr, "can't pin tick thread, --cpu ignored\n");
+    }
+    if (fifoPriority > 0 && !Realtime::setCurrentThreadFifo(fifoPriority)) {
+        fprintf(stderr, "can't switch to SCHED_FIFO, --fifo ignored\n");
+    }
+    if (isMemoryLocked && !Realtime::lockMemory(STACK_PREFAULT_BYTES, HEAP_PREFAULT_BYTES)) {
+        fprintf(stderr, "can't lock memory, check RLIMIT_MEMLOCK; pre-faulted only\n");
+    }
+
+    Realtime::setWorkerPolicy(workerCpus, fifoPriority);
+}
+
+unique_ptr<Transport> Runner::createTransport(const char* host, const char* port, const RunnerOptions& options) {
+    const string address = host;
+    unique_ptr<Transport> transport;
+
+#ifdef _LINUX
+    // local peers, port is ignored; both transports already send and receive from different threads
+    if (address.compare(0, 5, "unix:") == 0) {
+        unique_ptr<UnixSocketTransport> unixTransport(new UnixSocketTransport(address.substr(5)));
+        int descriptor = unixTransport->getDescriptor();
+        transport = std::move(unixTransport);
+        if (options.busyPollMicroseconds >= 0) {
+            transport.reset(new BusyPollTransport(std::move(transport), descriptor, options.busyPollMicroseconds));
+        }
+    } else if (address.compare(0, 4, "shm:") == 0) {
+        transport.reset(new ShmTransport(address.substr(4), false));
+    } else if (options.busyPollMicroseconds >= 0) {
+        // spinning in the reading thread replaces the receive-ahead I/O thread
+        unique_ptr<SocketTransport> socketTransport(new SocketTransport(host, atoi(port)));
+        int descriptor = socketTransport->getSocket().GetSocketDescriptor();
+        transport.reset(new BusyPollTransport(std::move(socketTransport), descriptor, options.busyPollMicroseconds));
+    } else if (options.isReceiveAhead) {
+        unique_ptr<SocketTransport> socketTransport(new SocketTransport(host, atoi(port)));
+        transport.reset(new ReceiveAheadTransport(std::move(socketTransport)));
+    }
+#else
+    if (options.isReceiveAhead || options.busyPollMicroseconds >= 0) {
+        fprintf(stderr, "--receive-ahead, --pipelined and --busy-poll are supported on Linux only\n");
+    }
+#endif
+    if (!transport) {
+        transport.reset(new SocketTransport(host, atoi(port)));
+    }
+
+    if (!options.recordPath.empty()) {
+        transport.reset(new RecordingTransport(std::move(transport), options.recordPath));
+    }
+
+    return transport;
+}
+
+Runner::Runner(const char* host, const char* port, const char* token, const RunnerOptions& options)
+        : remoteProcessClient(createTransport(host, port, options)), token(token), profilePath(options.profilePath), allocationsPath(options.allocationsPath), tracePath(options.tracePath), parameters(options.parameters),
+          isPipelined(options.isPipelined) {
+#ifndef _LINUX
+    // SocketTransport can't send and receive from different threads
+    isPipelined = false;
+#endif
 }
 
 void Runner::run() {
@@ -30,34 +197,92 @@ void Runner::run() {
     Game game = remoteProcessClient.readGameContextMessage();
 
     vector<Strategy*> strategies;
+    TeamContext team;
+    team.m_parameters = parameters;
+    if (!tracePath.empty()) {
+        team.m_decisionTrace.start();
+    }
 
     for (int strategyIndex = 0; strategyIndex < teamSize; ++strategyIndex) {
-        Strategy* strategy = new MyStrategy;
+        Strategy* strategy = new MyStrategy(team, teamSize);
         strategies.push_back(strategy);
     }
 
-    PlayerContext* playerContext;
+    unique_ptr<PlayerContextPipeline> pipeline;
+    if (isPipelined) {
+        pipeline.reset(new PlayerContextPipeline(remoteProcessClient));
+    }
+
+    // decoded in place every tick; the pipeline keeps its own two
+    PlayerContext decodedContext;
+    const PlayerContext* playerContext;
+
+    for (;;) {
+        {
+            ALLOCATION_SCOPE(eDECODE, false);
+            if (pipeline) {
+                // decoding runs on the pipeline thread, the tick thread only waits for it
+                PROFILE_SCOPE("wait");
+                playerContext = pipeline->next();
+            } else {
+                bool isPlayerContext;
+                {
+                    // idle until the server sends the next tick, not decode cost
+                    PROFILE_SCOPE("wait");
+                    isPlayerContext = remoteProcessClient.readPlayerContextMessageType();
+                }
+                PROFILE_SCOPE("decode");
+                playerContext = isPlayerContext && remoteProcessClient.readPlayerContextMessageBody(decodedContext) ? &decodedContext : NULL;
+            }
+        }
+        if (playerContext == NULL) {
+            break;
+        }
+
+        const int tick = playerContext->getWorld().getTick();
+        Log::setTick(tick);
 
-    while ((playerContext = remoteProcessClient.readPlayerContextMessage()) != NULL) {
-        vector<Hockeyist> playerHockeyists = playerContext->getHockeyists();
+        const Hockeyists& playerHockeyists = playerContext->getHockeyists();
         if ((int) playerHockeyists.size() != teamSize) {
             break;
         }
 
-        vector<Move> moves;
+        Moves moves(teamSize);
 
-        for (int hockeyistIndex = 0; hockeyistIndex < teamSize; ++hockeyistIndex) {
-            Hockeyist playerHockeyist = playerHockeyists[hockeyistIndex];
+        {
+            // the first tick sets up team state and scratch memory, every later one must not allocate
+            ALLOCATION_SCOPE(eSTRATEGY, tick > 0);
+            for (int hockeyistIndex = 0; hockeyistIndex < teamSize; ++hockeyistIndex) {
+                const Hockeyist& playerHockeyist = playerHockeyists[hockeyistIndex];
 
-            Move move;
-            strategies[playerHockeyist.getTeammateIndex()]
-                    ->move(playerHockeyist, playerContext->getWorld(), game, move);
-            moves.push_back(move);
+                strategies[playerHockeyist.getTeammateIndex()]
+                        ->move(playerHockeyist, playerContext->getWorld(), game, moves[hockeyistIndex]);
+            }
         }
 
-        remoteProcessClient.writeMovesMessage(moves);
+        {
+            PROFILE_SCOPE("encode");
+            ALLOCATION_SCOPE(eENCODE, false);
+            remoteProcessClient.writeMovesMessage(moves);
+        }
+
+        ALLOCATION_END_TICK(tick);
+        PROFILE_END_TICK(tick);
+    }
+
+    // stops a decoder still waiting for the next tick after a team size mismatch
+    pipeline.reset();
+
+    if (!tracePath.empty() && !team.m_decisionTrace.write(tracePath)) {
+        fprintf(stderr, "can't write trace %s\n", tracePath.c_str());
+    }
+
+    if (!profilePath.empty() && !Profiler::dump(profilePath)) {
+        fprintf(stderr, "can't write profile %s\n", profilePath.c_str());
+    }
 
-        delete playerContext;
+    if (!allocationsPath.empty() && !AllocationTracker::report(allocationsPath)) {
+        fprintf(stderr, "can't write allocation report %s\n", allocationsPath.c_str());
     }
 
     for (int strategyIndex = 0; strategyIndex < teamSize; ++strategyIndex) {
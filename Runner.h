@@ -3,16 +3,54 @@
 #ifndef _RUNNER_H_
 #define _RUNNER_H_
 
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "Parameters.h"
 #include "RemoteProcessClient.h"
 
+// Optional command line switches after host, port and token.
+struct RunnerOptions {
+    std::string recordPath; // --record <file>: copy all received bytes for offline replay, our moves to <file>.sent
+    std::string profilePath; // --profile <file>: per-tick timings and counters at game end, needs USE_PROFILER build
+    std::string logPath; // --log <file>: strategy log written by background thread, needs USE_LOG build
+    std::string tracePath; // --trace <file>: per-tick decision trace written at game end, see tools/TraceAnalyzer
+    std::string parametersPath; // --params <file>: strategy constants overriding built-in defaults, see Parameters.h
+    Parameters parameters; // loaded from parametersPath by main()
+    bool isReceiveAhead; // --receive-ahead: socket is read by I/O thread into a queue while strategy runs, Linux only
+    bool isPipelined; // --pipelined: next PLAYER_CONTEXT is decoded by its own thread while strategy runs, implies --receive-ahead
+    int busyPollMicroseconds; // --busy-poll <us>: spin on non-blocking recv() that long before blocking, 0 forever, -1 off; Linux only
+    std::vector<int> tickCpus; // --cpu <list>: pin the tick thread, e.g. 2 or 2,3; Linux only
+    std::vector<int> workerCpus; // --worker-cpus <list>: pin socket reader and decoder threads, default same as tick thread
+    int fifoPriority; // --fifo <1..99>: SCHED_FIFO for tick and worker threads, 0 off; needs CAP_SYS_NICE
+    bool isMemoryLocked; // --mlock: mlockall() and pre-fault stack and heap before connecting
+    std::string allocationsPath; // --allocations <file>: heap allocations per subsystem at game end, needs USE_ALLOCATION_TRACKING build
+    // --no-alloc log|abort: what an allocation by the strategy after the first tick does, set on AllocationTracker directly
+
+    RunnerOptions() : isReceiveAhead(false), isPipelined(false), busyPollMicroseconds(-1), fifoPriority(0), isMemoryLocked(false) {}
+
+    // Returns false on unknown or malformed switch.
+    bool parse(int argc, char* argv[]);
+
+    // Applies --cpu, --fifo and --mlock to the calling thread and process, records worker placement for threads
+    // started later. Warns and goes on when the host doesn't allow it.
+    void applyRealtime() const;
+};
+
 class Runner {
 private:
     RemoteProcessClient remoteProcessClient;
     std::string token;
+    std::string profilePath;
+    std::string allocationsPath;
+    std::string tracePath;
+    Parameters parameters;
+    bool isPipelined;
+
+    static std::unique_ptr<Transport> createTransport(const char* host, const char* port, const RunnerOptions& options);
 public:
-    Runner(const char*, const char*, const char*);
+    Runner(const char*, const char*, const char*, const RunnerOptions& options = RunnerOptions());
 
     void run();
 };
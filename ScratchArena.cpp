@@ -0,0 +1,42 @@
+#include "ScratchArena.h"
+
+#include <algorithm>
+
+const size_t ScratchArena::kBLOCK_SIZE;
+
+ScratchArena::ScratchArena()
+	: m_block(0)
+	, m_offset(0)
+{
+	m_blocks.reserve(8);
+	m_blockSizes.reserve(8);
+	m_blocks.push_back(std::unique_ptr<char[]>(new char[kBLOCK_SIZE]));
+	m_blockSizes.push_back(kBLOCK_SIZE);
+}
+
+void* ScratchArena::allocateSlow(size_t size, size_t alignment)
+{
+	// current block is full, take the next kept block big enough or add one
+	if (m_block < m_blocks.size())
+		++m_block;
+	while (m_block < m_blocks.size() && m_blockSizes[m_block] < size + alignment)
+		++m_block;
+
+	if (m_block == m_blocks.size())
+	{
+		const size_t blockSize = std::max(kBLOCK_SIZE, size + alignment);
+		m_blocks.push_back(std::unique_ptr<char[]>(new char[blockSize]));
+		m_blockSizes.push_back(blockSize);
+	}
+
+	m_offset = 0;
+	return allocate(size, alignment);
+}
+
+size_t ScratchArena::getCapacity() const
+{
+	size_t capacity = 0;
+	for (size_t size: m_blockSizes)
+		capacity += size;
+	return capacity;
+}
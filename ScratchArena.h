@@ -0,0 +1,79 @@
+#pragma once
+
+#ifndef _SCRATCH_ARENA_H_
+#define _SCRATCH_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+//! Bump allocator for strategy scratch data living within one MyStrategy::move(): allocation is a pointer
+//! increment, deallocation is a no-op, reset() releases everything at once. Blocks are kept across resets,
+//! so after the first ticks have grown the arena no tick calls malloc. Not thread safe, one per team.
+class ScratchArena
+{
+public:
+	static const size_t kBLOCK_SIZE = 64 * 1024;
+
+private:
+	std::vector<std::unique_ptr<char[]>> m_blocks;
+	std::vector<size_t>                  m_blockSizes;
+	size_t                               m_block;    //!< current block index
+	size_t                               m_offset;   //!< next free byte in current block
+
+	void* allocateSlow(size_t size, size_t alignment);
+
+	ScratchArena(const ScratchArena&);            //!< denied
+	ScratchArena& operator=(const ScratchArena&); //!< denied
+
+public:
+	//! first block is allocated up front, so a move() that fits in it never allocates
+	ScratchArena();
+
+	//! alignment up to that of malloc, offsets are aligned relative to block start
+	void* allocate(size_t size, size_t alignment)
+	{
+		if (m_block < m_blocks.size())
+		{
+			const size_t aligned = (m_offset + alignment - 1) & ~(alignment - 1);
+			if (aligned + size <= m_blockSizes[m_block])
+			{
+				m_offset = aligned + size;
+				return m_blocks[m_block].get() + aligned;
+			}
+		}
+		return allocateSlow(size, alignment);
+	}
+
+	//! everything allocated since the previous reset is gone
+	void reset() { m_block = 0; m_offset = 0; }
+
+	size_t getCapacity() const;
+};
+
+//! std allocator over a ScratchArena, for containers that die before the next reset
+template <typename T>
+class ScratchAllocator
+{
+	template <typename U> friend class ScratchAllocator;
+
+	ScratchArena* m_arena;
+
+public:
+	typedef T value_type;
+
+	explicit ScratchAllocator(ScratchArena& arena) : m_arena(&arena) {}
+	template <typename U> ScratchAllocator(const ScratchAllocator<U>& other) : m_arena(other.m_arena) {}
+
+	T*   allocate(size_t n)         { return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T))); }
+	void deallocate(T*, size_t)     {}
+
+	template <typename U> bool operator==(const ScratchAllocator<U>& other) const { return m_arena == other.m_arena; }
+	template <typename U> bool operator!=(const ScratchAllocator<U>& other) const { return m_arena != other.m_arena; }
+};
+
+template <typename T>
+using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+
+#endif
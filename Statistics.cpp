@@ -4,18 +4,11 @@
 #include <ctime>
 #include <fstream>
 
-std::unique_ptr<Statistics> Statistics::m_instance;
-void Statistics::init(const Range& subsituteRange, Statistics::Side mySide, const std::string& playerName)
-{
-	assert(!m_instance && "Can't reinitialize");
-	m_instance.reset(new Statistics(subsituteRange, mySide, playerName));
-}
-
 Statistics::~Statistics()
 {
 #ifdef USE_LOG
 	// unload statistics to file
-	const std::string filename = "stats_" + toString(time(nullptr)) + "_" + toString(clock()) + ".log";
+	const std::string filename = "stats_" + std::to_string(time(nullptr)) + "_" + std::to_string(clock()) + ".log";
 
 	std::ofstream out = std::ofstream(filename, std::ios::trunc);
 	out << "Finished. Side: " << (m_mySide == eLEFT_SIDE ? "left" : "right") << std::endl
@@ -23,21 +16,11 @@ Statistics::~Statistics()
 #endif
 }
 
-void Statistics::onPuckLoose()
-{
-	while (!m_plCallbacks.empty())
-	{
-		TPuckLooseCallback callback = std::move(m_plCallbacks.top());
-		m_plCallbacks.pop();
-		callback();
-	}
-}
-
 std::string PlayerStatistics::toString()
 {
 #ifdef USE_LOG
-	return m_name + "; score: " + ::toString(m_goalsMade) + "; got: " + ::toString(m_goalsGot) 
-	              + "; attacks: " + ::toString(m_attacksCount) + "(" + ::toString(m_goalsMade * 100.0 / m_attacksCount)
+	return m_name + "; score: " + std::to_string(m_goalsMade) + "; got: " + std::to_string(m_goalsGot) 
+	              + "; attacks: " + std::to_string(m_attacksCount) + "(" + std::to_string(m_goalsMade * 100.0 / m_attacksCount)
 				  + "%); crashed: " + std::string(m_isCrashed ? "true" : "false");
 #else
 	return std::string();
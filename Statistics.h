@@ -2,8 +2,6 @@
 #include "Utils.h"
 #include <memory>
 #include <string>
-#include <functional>
-#include <stack>
 
 struct PlayerStatistics
 {
@@ -45,38 +43,29 @@ public:
 	};
 
 	typedef long long              TId;
-	typedef std::function<void()>  TPuckLooseCallback;
 
 private:
 	Range               m_subsituteRange;
 	Side                m_mySide;
+	TId                 m_myPlayerId;
 	PlayerStatistics    m_player;
 	PuckStatistics      m_puck;
 
-	std::stack<TPuckLooseCallback>     m_plCallbacks;
-	static std::unique_ptr<Statistics> m_instance;
-
-	Statistics(const Range& subsituteRange, Side mySide, const std::string& playerName ) 
-		: m_subsituteRange(subsituteRange), m_mySide(mySide), m_player(playerName), m_puck()
-	{}
-
 	Statistics(const Statistics&); //!< denied
 	
 public:
+	Statistics(const Range& subsituteRange, Side mySide, TId myPlayerId, const std::string& playerName ) 
+		: m_subsituteRange(subsituteRange), m_mySide(mySide), m_myPlayerId(myPlayerId), m_player(playerName), m_puck()
+	{}
 
 	~Statistics();
-	
-	static Statistics*  instance()                    { return m_instance.get(); }
-	static void init(const Range& subsituteRange, Statistics::Side mySide, const std::string& playerName);
 
 	Side         getMySide()            const { return m_mySide; }
+	TId          getMyPlayerId()        const { return m_myPlayerId; }
 	const Range& getSubstitutionRange() const { return m_subsituteRange; }
 
 	PlayerStatistics& getPlayer()             {return m_player;}
 	PuckStatistics&   getPuck()               {return m_puck;}
-
-	void registerOnPuckLoose(TPuckLooseCallback&& c)	{m_plCallbacks.push(std::move(c));}
-	void onPuckLoose();
 };
 
 
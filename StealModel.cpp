@@ -0,0 +1,135 @@
+#include "StealModel.h"
+#include "MyStrategy.h"
+#include "Profiler.h"
+
+using namespace model;
+
+namespace
+{
+	static const double kTAKE_PUCK_VALUE    = 1.0;   // puck is ours
+	static const double kKNOCKDOWN_VALUE    = 0.7;   // puck is free, but still should be picked up
+	static const double kPUCK_SPEED_PENALTY = 0.01;  // faster puck is harder to pick up, per unit of relative speed
+	static const double kOWNER_STAYS_CHANCE = 0.9;   // owner won't leave stick reach during one more swing tick
+	static const double kSWINGING_OWNER     = 0.5;   // swinging owner is about to strike - no time to swing
+}
+
+StealModel::StealModel()
+	: m_game(nullptr)
+	, m_attributes(nullptr)
+	, m_tick(-1)
+{
+}
+
+double StealModel::clampChance(double chance) const
+{
+	return std::max(m_game->getMinActionChance(), std::min(m_game->getMaxActionChance(), chance));
+}
+
+double StealModel::getTakePuckChance(const Hockeyist& taker, const Puck& puck, const Hockeyist* owner) const
+{
+	const double handling = m_attributes->get(taker).getHandling();
+	if (owner)
+		return clampChance(m_game->getTakePuckAwayBaseChance() + handling - m_attributes->get(*owner).m_strength);
+
+	const double relativeSpeed = toVectorSpeed(puck.getSpeedX() - taker.getSpeedX(), puck.getSpeedY() - taker.getSpeedY());
+	return clampChance(m_game->getPickUpPuckBaseChance() + handling - 1.0 - relativeSpeed * kPUCK_SPEED_PENALTY);
+}
+
+double StealModel::getStrikePower(int swingTicks) const
+{
+	return m_game->getStrikePowerBaseFactor() + m_game->getStrikePowerGrowthFactor() * std::min(swingTicks, m_game->getMaxEffectiveSwingTicks());
+}
+
+double StealModel::getKnockdownChance(const Hockeyist& striker, const Hockeyist& victim, int swingTicks) const
+{
+	const double strength = m_attributes->get(striker).m_strength;
+	const double agility  = std::max(m_attributes->get(victim).m_agility, 0.01);
+	return clampChance(m_game->getKnockdownChanceFactor() * getStrikePower(swingTicks) * strength / agility);
+}
+
+bool StealModel::isInStickReach(const Hockeyist& h, double x, double y) const
+{
+	return h.getDistanceTo(x, y) < m_game->getStickLength() && std::abs(h.getAngleTo(x, y)) < m_game->getStickSector() / 2;
+}
+
+StealModel::Decision StealModel::decide(const World& world, const Hockeyist& self, const Hockeyist* owner) const
+{
+	const Puck& puck = world.getPuck();
+	Decision    best;
+
+	if (isInStickReach(self, puck.getX(), puck.getY()))
+	{
+		const double chance = getTakePuckChance(self, puck, owner);
+		best = Decision(TAKE_PUCK, chance, chance * kTAKE_PUCK_VALUE);
+	}
+
+	const Point      selfPos         = Point(self.getX(), self.getY());
+	const Hockeyist* teammateBetween = !owner ? nullptr : find_unit(world.getHockeyists(), [&self, &selfPos, owner](const Hockeyist& h)
+	{
+		return h.isTeammate() && h.getId() != self.getId() && MyStrategy::isInBetween(selfPos, h, *owner, self.getRadius());
+	});
+	const Hockeyist* enemyBetween = !owner ? nullptr : find_unit(world.getHockeyists(), [&self, &selfPos, owner](const Hockeyist& h)
+	{
+		return !h.isTeammate() && h.getId() != owner->getId() && MyStrategy::isInBetween(selfPos, h, *owner, self.getRadius());
+	});
+
+	if (enemyBetween != nullptr)
+		teammateBetween = nullptr; // don't miss a chance to hit two enemies
+
+	if (owner && !teammateBetween && isInStickReach(self, owner->getX(), owner->getY()))
+	{
+		const bool   isSwinging  = self.getState() == SWINGING;
+		const int    swingTicks  = isSwinging ? self.getSwingTicks() : 0;
+		const double strikeNow   = getKnockdownChance(self, *owner, swingTicks);
+		const double strikeLater = getKnockdownChance(self, *owner, swingTicks + 1) * (owner->getState() == SWINGING ? kSWINGING_OWNER : kOWNER_STAYS_CHANCE);
+
+		if (strikeNow * kKNOCKDOWN_VALUE > best.m_value && (isSwinging || strikeNow >= strikeLater))
+			best = Decision(STRIKE, strikeNow, strikeNow * kKNOCKDOWN_VALUE);
+		else if (!isSwinging && strikeLater * kKNOCKDOWN_VALUE > best.m_value)
+			best = Decision(SWING, strikeLater, strikeLater * kKNOCKDOWN_VALUE);
+	}
+
+	if (self.getState() == SWINGING && best.m_action != STRIKE)
+		best = Decision(CANCEL_STRIKE, 0, 0);
+
+	return best;
+}
+
+void StealModel::evaluate(const World& world, const Game& game, const AttributeCache& attributes)
+{
+	if (m_tick == world.getTick())
+		return;
+
+	PROFILE_SCOPE("StealModel::evaluate");
+	m_game       = &game;
+	m_attributes = &attributes;
+	m_tick = world.getTick();
+	std::fill(std::begin(m_decisions), std::end(m_decisions), Decision());
+
+	const Puck&      puck    = world.getPuck();
+	const long long  ownerId = puck.getOwnerHockeyistId();
+	const Hockeyist* owner   = find_unit(world.getHockeyists(), [ownerId](const Hockeyist& h) { return !h.isTeammate() && h.getId() == ownerId; });
+
+	double bestTake = 0;
+	for (const Hockeyist& h: world.getHockeyists())
+	{
+		if (!h.isTeammate() || h.getType() == GOALIE || h.getState() == RESTING || h.getState() == KNOCKED_DOWN)
+			continue;
+
+		if (h.getTeammateIndex() < 0 || h.getTeammateIndex() >= kMAX_TEAMMATES)
+			continue;
+
+		Decision& decision = m_decisions[h.getTeammateIndex()];
+		decision = decide(world, h, owner);
+
+		if (decision.m_action == TAKE_PUCK)
+			bestTake = std::max(bestTake, decision.m_value);
+	}
+
+	// coordinated pressure: swing blocks the stick for a while, so don't start it if a teammate is more likely to just take the puck
+	for (Decision& decision: m_decisions)
+	{
+		if (decision.m_action == SWING && decision.m_value < bestTake)
+			decision = Decision();
+	}
+}
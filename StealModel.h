@@ -0,0 +1,54 @@
+#pragma once
+
+#ifndef _STEAL_MODEL_H_
+#define _STEAL_MODEL_H_
+
+#include "Utils.h"
+#include "AttributeCache.h"
+#include "model/Game.h"
+#include "model/World.h"
+
+//! Chances to get puck from opponent by TAKE_PUCK or by knocking its owner down, and per-teammate choice of the best one.
+class StealModel
+{
+public:
+	static const int kMAX_TEAMMATES = 8;
+
+	struct Decision
+	{
+		model::ActionType m_action;         //!< NONE if nothing is worth trying this tick
+		double            m_probability;    //!< chance of the chosen action to succeed
+		double            m_value;          //!< probability weighted by usefulness of the outcome
+
+		Decision() : m_action(model::NONE), m_probability(0), m_value(0) {}
+		Decision(model::ActionType a, double p, double v) : m_action(a), m_probability(p), m_value(v) {}
+	};
+
+private:
+	const model::Game*    m_game;
+	const AttributeCache* m_attributes;
+	int                m_tick;
+	Decision           m_decisions[kMAX_TEAMMATES];  //!< indexed by teammate index
+
+	double clampChance(double chance) const;
+	Decision decide(const model::World& world, const model::Hockeyist& self, const model::Hockeyist* owner) const;
+
+public:
+	StealModel();
+
+	//! chance to pick up free puck, or take it away from owner (if any)
+	double getTakePuckChance(const model::Hockeyist& taker, const model::Puck& puck, const model::Hockeyist* owner) const;
+
+	//! chance to knock victim down by strike with given swing duration
+	double getKnockdownChance(const model::Hockeyist& striker, const model::Hockeyist& victim, int swingTicks) const;
+
+	double getStrikePower(int swingTicks) const;
+	bool   isInStickReach(const model::Hockeyist& h, double x, double y) const;
+
+	//! evaluate all teammates at once, so they don't waste cooldowns on the same opponent. No-op if already done for this tick.
+	void evaluate(const model::World& world, const model::Game& game, const AttributeCache& attributes);
+
+	const Decision& getDecision(int teammateIndex) const { return m_decisions[teammateIndex]; }
+};
+
+#endif
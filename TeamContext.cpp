@@ -0,0 +1,11 @@
+#include "TeamContext.h"
+#include "Statistics.h"
+
+TeamContext::TeamContext()
+	: m_initialDefenderId(-1)
+{
+}
+
+TeamContext::~TeamContext()
+{
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#ifndef _TEAM_CONTEXT_H_
+#define _TEAM_CONTEXT_H_
+
+#include "Utils.h"
+#include "PathPlanner.h"
+#include "StealModel.h"
+#include "AttributeCache.h"
+#include "Plan.h"
+#include "EventBus.h"
+#include "Parameters.h"
+#include "ScratchArena.h"
+#include "DecisionTrace.h"
+#include <map>
+#include <memory>
+
+class Statistics;
+
+//! Game state shared by all hockeyists of one team. Owned by whoever creates the strategies (runner, simulator),
+//! so both teams or many games can run in one process.
+struct TeamContext
+{
+	typedef long long TId;
+
+	Parameters                   m_parameters;       // tunable constants, set before the first tick
+	TId                          m_initialDefenderId;
+	std::map<TId, PreferredFire> m_firePositionMap;  // id of hockeyist which wants to fire from far (not near!) angle
+	PathPlanner                  m_pathPlanner;      // opponents avoidance, shared by teammates within a tick
+	StealModel                   m_stealModel;       // puck steal decisions for all teammates, evaluated once per tick
+	AttributeCache               m_attributes;       // stamina-scaled attributes of all hockeyists, updated once per tick
+	std::map<TId, Plan>          m_plans;            // decisions kept across ticks
+	EventBus                     m_events;           // game state transitions, detected once per tick
+	std::unique_ptr<Statistics>  m_statistics;       // created on first tick, when side is known
+	ScratchArena                 m_scratch;          // per-move temporaries, reset at the start of every MyStrategy::move()
+	DecisionTrace                m_decisionTrace;    // rows of all teammates, started by the owner when tracing
+
+	TeamContext();
+	~TeamContext();
+
+private:
+	TeamContext(const TeamContext&);            //!< denied
+	TeamContext& operator=(const TeamContext&); //!< denied
+};
+
+#endif
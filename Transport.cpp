@@ -0,0 +1,131 @@
+#include "Transport.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+void Transport::interrupt() {
+}
+
+void Transport::close() {
+}
+
+Transport::~Transport() {
+}
+
+SocketTransport::SocketTransport(const string& host, int port) {
+    socket.Initialize();
+    socket.DisableNagleAlgoritm();
+
+    if (!socket.Open((uint8*) host.c_str(), (int16) port)) {
+        exit(10001);
+    }
+}
+
+int SocketTransport::receive(void* buffer, int byteCount) {
+    int receivedByteCount = socket.Receive(byteCount);
+    if (receivedByteCount > 0) {
+        memcpy(buffer, socket.GetData(), receivedByteCount);
+    }
+    return receivedByteCount;
+}
+
+int SocketTransport::send(const void* data, int byteCount) {
+    return socket.Send((const uint8*) data, byteCount);
+}
+
+void SocketTransport::interrupt() {
+    // not CSimpleSocket::Shutdown(), it always shuts down the sending side
+    shutdown(socket.GetSocketDescriptor(), CSimpleSocket::Receives);
+}
+
+void SocketTransport::close() {
+    socket.Close();
+}
+
+MemoryTransport::MemoryTransport()
+        : inputOffset(0) {
+}
+
+MemoryTransport::MemoryTransport(const vector<signed char>& input)
+        : input(input), inputOffset(0) {
+}
+
+int MemoryTransport::receive(void* buffer, int byteCount) {
+    int available = (int) min<size_t>(byteCount, input.size() - inputOffset);
+    if (available > 0) {
+        memcpy(buffer, &input[inputOffset], available);
+        inputOffset += available;
+    }
+    return available;
+}
+
+int MemoryTransport::send(const void* data, int byteCount) {
+    const signed char* bytes = (const signed char*) data;
+    output.insert(output.end(), bytes, bytes + byteCount);
+    return byteCount;
+}
+
+void MemoryTransport::setInput(const vector<signed char>& bytes) {
+    input = bytes;
+    inputOffset = 0;
+}
+
+RecordingTransport::RecordingTransport(unique_ptr<Transport> transport, const string& path)
+        : transport(std::move(transport)), file(fopen(path.c_str(), "wb")), sentFile(fopen((path + ".sent").c_str(), "wb")) {
+}
+
+int RecordingTransport::receive(void* buffer, int byteCount) {
+    int receivedByteCount = transport->receive(buffer, byteCount);
+    if (receivedByteCount > 0 && file != NULL) {
+        fwrite(buffer, 1, receivedByteCount, file);
+    }
+    return receivedByteCount;
+}
+
+int RecordingTransport::send(const void* data, int byteCount) {
+    int sentByteCount = transport->send(data, byteCount);
+    if (sentByteCount > 0 && sentFile != NULL) {
+        fwrite(data, 1, sentByteCount, sentFile);
+    }
+    return sentByteCount;
+}
+
+void RecordingTransport::interrupt() {
+    transport->interrupt();
+}
+
+void RecordingTransport::close() {
+    if (file != NULL) {
+        fclose(file);
+        file = NULL;
+    }
+    if (sentFile != NULL) {
+        fclose(sentFile);
+        sentFile = NULL;
+    }
+    transport->close();
+}
+
+RecordingTransport::~RecordingTransport() {
+    this->close();
+}
+
+vector<signed char> readFileBytes(const string& path) {
+    vector<signed char> bytes;
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == NULL) {
+        return bytes;
+    }
+
+    signed char buffer[64 * 1024];
+    size_t readByteCount;
+    while ((readByteCount = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + readByteCount);
+    }
+
+    fclose(file);
+    return bytes;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#ifndef _TRANSPORT_H_
+#define _TRANSPORT_H_
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "csimplesocket/ActiveSocket.h"
+
+// Byte stream RemoteProcessClient talks over.
+class Transport {
+public:
+    // Reads up to byteCount bytes, returns number of bytes read, 0 or negative on end of stream or error.
+    virtual int receive(void* buffer, int byteCount) = 0;
+
+    // Writes up to byteCount bytes, returns number of bytes written, 0 or negative on error.
+    virtual int send(const void* data, int byteCount) = 0;
+
+    // Makes a receive() blocked in another thread, and every later one, return 0 or less once the bytes already
+    // buffered are read; send() keeps working. Nothing to do for transports which never block.
+    virtual void interrupt();
+
+    virtual void close();
+
+    virtual ~Transport();
+};
+
+// TCP connection to the game runner.
+class SocketTransport : public Transport {
+private:
+    CActiveSocket socket;
+public:
+    SocketTransport(const std::string& host, int port);
+
+    int receive(void* buffer, int byteCount);
+    int send(const void* data, int byteCount);
+    void interrupt();
+    void close();
+
+    CActiveSocket& getSocket() { return socket; }
+};
+
+// In-memory stream: reads prepared input, collects output. Used by benchmarks and replays.
+class MemoryTransport : public Transport {
+private:
+    std::vector<signed char> input;
+    size_t inputOffset;
+    std::vector<signed char> output;
+public:
+    MemoryTransport();
+    explicit MemoryTransport(const std::vector<signed char>& input);
+
+    int receive(void* buffer, int byteCount);
+    int send(const void* data, int byteCount);
+
+    void setInput(const std::vector<signed char>& bytes);
+    void rewind() { inputOffset = 0; }
+    bool isInputEnd() const { return inputOffset >= input.size(); }
+
+    const std::vector<signed char>& getOutput() const { return output; }
+    void clearOutput() { output.clear(); }
+};
+
+// Copies all received bytes to a file, so the game can be replayed offline through MemoryTransport,
+// and all sent ones (our moves) to the same path with ".sent" appended.
+class RecordingTransport : public Transport {
+private:
+    std::unique_ptr<Transport> transport;
+    FILE* file;
+    FILE* sentFile;
+public:
+    RecordingTransport(std::unique_ptr<Transport> transport, const std::string& path);
+
+    int receive(void* buffer, int byteCount);
+    int send(const void* data, int byteCount);
+    void interrupt();
+    void close();
+
+    ~RecordingTransport();
+};
+
+// Whole file as input for MemoryTransport, empty if it can't be read.
+std::vector<signed char> readFileBytes(const std::string& path);
+
+#endif
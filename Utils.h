@@ -9,13 +9,10 @@
 #endif
 
 #ifdef USE_LOG
-#	include <windows.h>
-    inline void debugPrint(const std::string& s)		            {::OutputDebugStringA((s+"\n").c_str());}
-    template <typename T> std::string toString(const T& var)        {return std::to_string(var);}
-
+#	include "Log.h"
+#	define LOG(...) Log::write(__VA_ARGS__)
 #else
-#	define debugPrint(x) ;
-    template <typename T> std::string toString(const T& var)        {static const std::string fake; return fake;}
+#	define LOG(...) ;
 #endif // USE_LOG
 
 inline double toDegrees(double radian)                          { return radian * 180.0 / PI; }
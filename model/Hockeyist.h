@@ -6,6 +6,7 @@
 #include "ActionType.h"
 #include "HockeyistState.h"
 #include "HockeyistType.h"
+#include "StaticVector.h"
 #include "Unit.h"
 
 namespace model {
@@ -52,6 +53,9 @@ namespace model {
         ActionType getLastAction() const;
         int getLastActionTick() const;
     };
+
+    // up to six per team with substitutes, plus goalies
+    typedef StaticVector<Hockeyist, 16> Hockeyists;
 }
 
 #endif
@@ -4,6 +4,7 @@
 #define _MOVE_H_
 
 #include "ActionType.h"
+#include "StaticVector.h"
 
 namespace model {
     class Move {
@@ -30,6 +31,9 @@ namespace model {
         int getTeammateIndex() const;
         void setTeammateIndex(const int teammateIndex);
     };
+
+    // one per controlled hockeyist, team size is at most six
+    typedef StaticVector<Move, 6> Moves;
 }
 
 #endif
@@ -1,18 +1,27 @@
 #include "Player.h"
 
+#include <algorithm>
+#include <cstring>
+
 using namespace model;
 using namespace std;
 
 Player::Player()
-        : id(-1), me(false), name(""), goalCount(-1), strategyCrashed(false), netTop(-1.0), netLeft(-1.0),
-        netBottom(-1.0), netRight(-1.0), netFront(-1.0), netBack(-1.0), justScoredGoal(false), justMissedGoal(false) { }
+        : id(-1), me(false), goalCount(-1), strategyCrashed(false), netTop(-1.0), netLeft(-1.0),
+        netBottom(-1.0), netRight(-1.0), netFront(-1.0), netBack(-1.0), justScoredGoal(false), justMissedGoal(false) {
+    name[0] = '\0';
+}
 
 Player::Player(long long id, bool me, const string& name, int goalCount, bool strategyCrashed, double netTop,
         double netLeft, double netBottom, double netRight, double netFront, double netBack, bool justScoredGoal,
         bool justMissedGoal)
-        : id(id), me(me), name(name), goalCount(goalCount), strategyCrashed(strategyCrashed), netTop(netTop),
+        : id(id), me(me), goalCount(goalCount), strategyCrashed(strategyCrashed), netTop(netTop),
         netLeft(netLeft), netBottom(netBottom), netRight(netRight), netFront(netFront), netBack(netBack),
-        justScoredGoal(justScoredGoal), justMissedGoal(justMissedGoal) { }
+        justScoredGoal(justScoredGoal), justMissedGoal(justMissedGoal) {
+    size_t length = min(name.size(), NAME_CAPACITY - 1);
+    memcpy(this->name, name.data(), length);
+    this->name[length] = '\0';
+}
 
 long long Player::getId() const {
     return id;
@@ -22,7 +31,7 @@ bool Player::isMe() const {
     return me;
 }
 
-const string& Player::getName() const {
+const char* Player::getName() const {
     return name;
 }
 
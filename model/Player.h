@@ -3,14 +3,20 @@
 #ifndef _PLAYER_H_
 #define _PLAYER_H_
 
+#include <cstddef>
 #include <string>
 
+#include "StaticVector.h"
+
 namespace model {
     class Player {
+    public:
+        // longer names are truncated, so a Player stays plain data
+        static const std::size_t NAME_CAPACITY = 64;
     private:
         long long id;
         bool me;
-        std::string name;
+        char name[NAME_CAPACITY];
         int goalCount;
         bool strategyCrashed;
         double netTop;
@@ -29,7 +35,7 @@ namespace model {
 
         long long getId() const;
         bool isMe() const;
-        const std::string& getName() const;
+        const char* getName() const;
         int getGoalCount() const;
         bool isStrategyCrashed() const;
         double getNetTop() const;
@@ -41,6 +47,8 @@ namespace model {
         bool isJustScoredGoal() const;
         bool isJustMissedGoal() const;
     };
+
+    typedef StaticVector<Player, 2> Players;
 }
 
 #endif
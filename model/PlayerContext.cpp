@@ -4,12 +4,12 @@ using namespace model;
 using namespace std;
 
 PlayerContext::PlayerContext()
-        : hockeyists(vector<Hockeyist> ()), world(World ()) { }
+        : hockeyists(Hockeyists ()), world(World ()) { }
 
-PlayerContext::PlayerContext(const vector<Hockeyist>& hockeyists, const World& world)
+PlayerContext::PlayerContext(const Hockeyists& hockeyists, const World& world)
         : hockeyists(hockeyists), world(world) { }
 
-const vector<Hockeyist>& PlayerContext::getHockeyists() const {
+const Hockeyists& PlayerContext::getHockeyists() const {
     return hockeyists;
 }
 
@@ -0,0 +1,101 @@
+#pragma once
+
+#ifndef _STATIC_VECTOR_H_
+#define _STATIC_VECTOR_H_
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace model {
+    // Vector with inline storage for at most Capacity elements: no heap, and a copy is one contiguous block.
+    // Unit counts in a game are small and fixed, so the protocol reader checks each count against the capacity
+    // and the rest of the code never has to.
+    // Elements must be trivially copyable; the vector then is too, so snapshots holding it can be memcpy'd.
+    template <typename T, std::size_t Capacity>
+    class StaticVector {
+        static_assert(std::is_trivially_copyable<T>::value, "StaticVector elements must be trivially copyable");
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+    private:
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage[Capacity];
+        std::size_t count;
+
+        T* data() { return reinterpret_cast<T*>(storage); }
+        const T* data() const { return reinterpret_cast<const T*>(storage); }
+    public:
+        StaticVector() : count(0) { }
+
+        explicit StaticVector(std::size_t size) : count(0) {
+            resize(size);
+        }
+
+        template <typename Iterator>
+        StaticVector(Iterator first, Iterator last) : count(0) {
+            append(first, last);
+        }
+
+        StaticVector(const StaticVector& other) = default;
+        StaticVector& operator=(const StaticVector& other) = default;
+        ~StaticVector() = default;
+
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        static constexpr std::size_t capacity() { return Capacity; }
+
+        iterator begin() { return data(); }
+        iterator end() { return data() + count; }
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + count; }
+
+        T& operator[](std::size_t index) { return data()[index]; }
+        const T& operator[](std::size_t index) const { return data()[index]; }
+
+        T& front() { return data()[0]; }
+        const T& front() const { return data()[0]; }
+        T& back() { return data()[count - 1]; }
+        const T& back() const { return data()[count - 1]; }
+
+        void push_back(const T& value) {
+            assert(count < Capacity);
+            new (data() + count) T(value);
+            ++count;
+        }
+
+        void pop_back() {
+            --count;
+        }
+
+        void resize(std::size_t size) {
+            assert(size <= Capacity);
+            if (count > size) {
+                count = size;
+            }
+            while (count < size) {
+                new (data() + count) T();
+                ++count;
+            }
+        }
+
+        void clear() {
+            count = 0;
+        }
+    private:
+        template <typename Iterator>
+        void append(Iterator first, Iterator last) {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+    };
+}
+
+#endif
@@ -76,5 +76,3 @@ double Unit::getDistanceTo(double x, double y) const {
 double Unit::getDistanceTo(const Unit& unit) const {
     return this->getDistanceTo(unit.x, unit.y);
 }
-
-Unit::~Unit() { }
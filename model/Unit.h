@@ -33,8 +33,6 @@ namespace model {
         double getAngleTo(const Unit& unit) const;
         double getDistanceTo(double x, double y) const;
         double getDistanceTo(const Unit& unit) const;
-
-        virtual ~Unit();
     };
 }
 
@@ -1,14 +1,19 @@
 #include "World.h"
 
+#include <type_traits>
+
 using namespace model;
 using namespace std;
 
+// snapshots copied for look-ahead and replay stay a block copy of the used part
+static_assert(is_trivially_copyable<World>::value, "worlds must stay plain data");
+
 World::World()
-        : tick(-1), tickCount(-1), width(-1.0), height(-1.0), players(vector<Player> ()),
-        hockeyists(vector<Hockeyist> ()), puck(Puck ()) { }
+        : tick(-1), tickCount(-1), width(-1.0), height(-1.0), players(Players ()),
+        hockeyists(Hockeyists ()), puck(Puck ()) { }
 
-World::World(int tick, int tickCount, double width, double height, const vector<Player>& players,
-        const vector<Hockeyist>& hockeyists, const Puck& puck)
+World::World(int tick, int tickCount, double width, double height, const Players& players,
+        const Hockeyists& hockeyists, const Puck& puck)
         : tick(tick), tickCount(tickCount), width(width), height(height), players(players), hockeyists(hockeyists),
         puck(puck) { }
 
@@ -28,11 +33,11 @@ double World::getHeight() const {
     return height;
 }
 
-const vector<Player>& World::getPlayers() const {
+const Players& World::getPlayers() const {
     return players;
 }
 
-const vector<Hockeyist>& World::getHockeyists() const {
+const Hockeyists& World::getHockeyists() const {
     return hockeyists;
 }
 
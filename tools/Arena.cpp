@@ -0,0 +1,53 @@
+#include "Arena.h"
+#include "WorldFactory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+std::vector<MatchResult> playMatches(const TeamFactory& candidate, const TeamFactory& baseline, const Simulator::Options& options,
+	int matchCount, int threadCount)
+{
+	std::vector<MatchResult> results(std::max(matchCount, 0));
+	std::atomic<int>         nextMatch(0);
+
+	auto worker = [&]()
+	{
+		for (int match = nextMatch++; match < matchCount; match = nextMatch++)
+		{
+			MatchResult& r = results[match];
+			r.m_seed            = options.m_seed + match / 2;
+			r.m_isCandidateLeft = match % 2 == 0;
+
+			Simulator::Options matchOptions = options;
+			matchOptions.m_seed = r.m_seed;
+			matchOptions.m_recordPath = options.m_recordPath.empty() || !r.m_isCandidateLeft
+				? std::string() : options.m_recordPath + "/match-" + std::to_string(match) + ".rec";
+
+			const model::Game game = WorldFactory::makeGame(r.m_seed);
+			Team candidateTeam = candidate.create(options.m_teamSize);
+			Team baselineTeam  = baseline.create(options.m_teamSize);
+
+			Simulator simulator(game, matchOptions);
+			const Simulator::Result s = r.m_isCandidateLeft
+				? simulator.play(candidateTeam.m_strategies, baselineTeam.m_strategies)
+				: simulator.play(baselineTeam.m_strategies, candidateTeam.m_strategies);
+
+			const int side = r.m_isCandidateLeft ? Simulator::kLEFT : Simulator::kRIGHT;
+			r.m_candidateGoals     = s.m_goals[side];
+			r.m_baselineGoals      = s.m_goals[1 - side];
+			r.m_isOvertime         = s.m_isOvertime;
+			r.m_isCandidateCrashed = s.m_isCrashed[side];
+			r.m_isBaselineCrashed  = s.m_isCrashed[1 - side];
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (int i = 1; i < threadCount; ++i)
+		threads.push_back(std::thread(worker));
+	worker();
+	for (std::thread& t: threads)
+		t.join();
+
+	return results;
+}
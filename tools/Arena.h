@@ -0,0 +1,31 @@
+#pragma once
+
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+#include "Simulator.h"
+#include "Teams.h"
+#include <vector>
+
+//! Candidate's view of one simulated match
+struct MatchResult
+{
+	unsigned m_seed;
+	bool     m_isCandidateLeft;
+	int      m_candidateGoals;
+	int      m_baselineGoals;
+	bool     m_isOvertime;
+	bool     m_isCandidateCrashed;
+	bool     m_isBaselineCrashed;
+
+	//! 1 for win, 0.5 for draw
+	double getScore() const  { return m_candidateGoals > m_baselineGoals ? 1.0 : m_candidateGoals == m_baselineGoals ? 0.5 : 0.0; }
+};
+
+//! Plays candidate against baseline on several threads, results are in match order whatever the thread count.
+//! Pairs of matches share a seed (options.m_seed + match / 2) with sides swapped, so side and attribute luck cancel out.
+//! options.m_recordPath is a directory here: candidate's view of the matches it plays on the left goes to match-N.rec.
+std::vector<MatchResult> playMatches(const TeamFactory& candidate, const TeamFactory& baseline, const Simulator::Options& options,
+	int matchCount, int threadCount);
+
+#endif
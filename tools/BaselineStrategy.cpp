@@ -0,0 +1,31 @@
+#include "BaselineStrategy.h"
+#include "../Utils.h"
+
+using namespace model;
+
+void BaselineStrategy::move(const Hockeyist& self, const World& world, const Game& game, Move& move)
+{
+	const Puck&   puck     = world.getPuck();
+	const Player& opponent = world.getOpponentPlayer();
+
+	if (puck.getOwnerHockeyistId() != self.getId())
+	{
+		move.setSpeedUp(1.0);
+		move.setTurn(self.getAngleTo(puck));
+		move.setAction(self.getState() == SWINGING ? CANCEL_STRIKE : TAKE_PUCK);
+		return;
+	}
+
+	// aim at net corner farther from us
+	const double netY      = self.getY() < (opponent.getNetTop() + opponent.getNetBottom()) / 2
+		? opponent.getNetBottom() - puck.getRadius()
+		: opponent.getNetTop() + puck.getRadius();
+	const double angle     = self.getAngleTo(opponent.getNetFront(), netY);
+	const double distance  = self.getDistanceTo(opponent.getNetFront(), netY);
+
+	static const double kSTRIKE_DISTANCE = 400;
+	move.setTurn(angle);
+	move.setSpeedUp(distance > kSTRIKE_DISTANCE ? 1.0 : 0.2);
+	if (distance < kSTRIKE_DISTANCE && std::abs(angle) < game.getStrikeAngleDeviation() * 2)
+		move.setAction(STRIKE);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#ifndef _BASELINE_STRATEGY_H_
+#define _BASELINE_STRATEGY_H_
+
+#include "../Strategy.h"
+
+//! Stateless reference opponent for self-play: chase the puck, carry it to the far half of opponent's net and strike.
+class BaselineStrategy : public Strategy
+{
+public:
+	void move(const model::Hockeyist& self, const model::World& world, const model::Game& game, model::Move& move);
+};
+
+#endif
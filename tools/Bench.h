@@ -0,0 +1,127 @@
+#pragma once
+
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../AllocationTracker.h"
+
+//! Minimal microbenchmark harness: ns/op percentiles over samples and heap allocations per op
+namespace Bench
+{
+	//! number of operator new calls in this process, benchmarks link AllocationHooks.cpp
+	inline unsigned long long getAllocationCount() { return AllocationTracker::getCount(); }
+
+	template <typename T> inline void doNotOptimize(const T& value)
+	{
+#if defined(__GNUC__)
+		asm volatile("" : : "g"(&value) : "memory");
+#else
+		static const void* volatile sink;
+		sink = &value;
+#endif
+	}
+
+	struct Result
+	{
+		std::string m_name;
+		double      m_mean;
+		double      m_p50;
+		double      m_p90;
+		double      m_p99;
+		double      m_allocationsPerOp;
+	};
+
+	struct Options
+	{
+		unsigned    m_samples;
+		unsigned    m_opsPerSample;
+		std::string m_filter;
+
+		Options() : m_samples(200), m_opsPerSample(1000) {}
+
+		bool isSelected(const char* name) const { return m_filter.empty() || std::strstr(name, m_filter.c_str()) != nullptr; }
+	};
+
+	//! op(i) is called opsPerSample times per sample, i runs over all calls, so op can walk a corpus
+	template <typename Operation>
+	Result run(const char* name, const Options& options, unsigned opsPerSample, Operation op)
+	{
+		typedef std::chrono::steady_clock TClock;
+
+		std::vector<double> samples;
+		samples.reserve(options.m_samples);
+
+		// warm up caches and lazy statics
+		unsigned index = 0;
+		for (unsigned i = 0; i < opsPerSample; ++i)
+			op(index++);
+
+		unsigned long long allocations = 0;
+		for (unsigned sample = 0; sample < options.m_samples; ++sample)
+		{
+			const unsigned long long allocationsBefore = getAllocationCount();
+			const TClock::time_point start = TClock::now();
+
+			for (unsigned i = 0; i < opsPerSample; ++i)
+				op(index++);
+
+			const TClock::time_point finish = TClock::now();
+			allocations += getAllocationCount() - allocationsBefore;
+			samples.push_back(std::chrono::duration<double, std::nano>(finish - start).count() / opsPerSample);
+		}
+
+		std::sort(samples.begin(), samples.end());
+		auto percentile = [&samples](double p) { return samples[std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()))]; };
+
+		Result result;
+		result.m_name             = name;
+		result.m_mean             = 0;
+		for (double s: samples)
+			result.m_mean += s / samples.size();
+		result.m_p50              = percentile(0.50);
+		result.m_p90              = percentile(0.90);
+		result.m_p99              = percentile(0.99);
+		result.m_allocationsPerOp = static_cast<double>(allocations) / (static_cast<double>(options.m_samples) * opsPerSample);
+		return result;
+	}
+
+	inline void printHeader()
+	{
+		std::printf("%-36s %12s %12s %12s %12s %12s\n", "benchmark", "mean ns/op", "p50", "p90", "p99", "allocs/op");
+	}
+
+	inline void print(const Result& r)
+	{
+		std::printf("%-36s %12.1f %12.1f %12.1f %12.1f %12.3f\n", r.m_name.c_str(), r.m_mean, r.m_p50, r.m_p90, r.m_p99, r.m_allocationsPerOp);
+		std::fflush(stdout);
+	}
+
+	//! common command line switches: --samples N, --ops N, --filter substring. True if argv[i] is one of them, i is moved to its value then.
+	inline bool parseOption(int argc, char* argv[], int& i, Options& options)
+	{
+		const std::string arg = argv[i];
+		if (i + 1 >= argc)
+			return false;
+
+		if (arg == "--samples")
+			options.m_samples = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+		else if (arg == "--ops")
+			options.m_opsPerSample = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+		else if (arg == "--filter")
+			options.m_filter = argv[++i];
+		else
+			return false;
+
+		return true;
+	}
+}
+
+#endif
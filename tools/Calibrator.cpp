@@ -0,0 +1,245 @@
+#include "Recording.h"
+#include "../AttributeCache.h"
+#include "../Parameters.h"
+#include "../Utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Fits physics constants to consecutive ticks of recorded games. Moves of other players are unknown, so:
+// - hockeyist friction by least squares on speed across heading (acceleration is along it) and knocked down sliding,
+// - puck friction by least squares on free puck speed,
+// - speed up, speed down and turn scales from the 99th percentile of implied control / game factor, since
+//   strategies spend a lot of time at full throttle and full turn.
+// Units touching walls or each other are skipped, collisions aren't modelled.
+namespace
+{
+	using namespace model;
+
+	static const double kMARGIN          = 5;     // extra clearance to walls and units
+	static const int    kMIN_SAMPLES     = 100;   // below that the default is kept
+	static const double kSCALE_QUANTILE  = 0.99;
+
+	struct LeastSquares
+	{
+		double m_xy;
+		double m_xx;
+		int    m_count;
+
+		LeastSquares() : m_xy(0), m_xx(0), m_count(0) {}
+
+		void   add(double x, double y)  { m_xy += x * y; m_xx += x * x; ++m_count; }
+		double getSlope() const         { return m_xx > 0 ? m_xy / m_xx : 0; }
+	};
+
+	//! speed along new heading of active hockeyist, control is known once friction is fitted
+	struct Control
+	{
+		double m_along;
+		double m_nextAlong;
+		double m_agility;
+	};
+
+	struct Samples
+	{
+		LeastSquares         m_hockeyistFriction;
+		LeastSquares         m_puckFriction;
+		std::vector<Control> m_controls;
+		std::vector<double>  m_turn;         // implied turn / (turn factor * agility)
+		double               m_puckPathError;  // sum of squared position step errors of free puck
+	};
+
+	double normalizeAngle(double angle)
+	{
+		while (angle > PI)
+			angle -= 2 * PI;
+		while (angle < -PI)
+			angle += 2 * PI;
+		return angle;
+	}
+
+	double getQuantile(std::vector<double> values, double fraction)
+	{
+		const size_t n = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+		std::nth_element(values.begin(), values.begin() + n, values.end());
+		return values[n];
+	}
+
+	const Hockeyist* findHockeyist(const World& world, long long id)
+	{
+		return find_unit(world.getHockeyists(), [id](const Hockeyist& h) { return h.getId() == id; });
+	}
+
+	//! nothing to bounce off during the tick
+	bool isClear(const Game& game, const World& world, const Unit& unit, const Unit& next)
+	{
+		const double speed = std::max(toVectorSpeed(unit.getSpeedX(), unit.getSpeedY()), toVectorSpeed(next.getSpeedX(), next.getSpeedY()));
+		return ::isClear(game, world, unit, speed + kMARGIN);
+	}
+
+	void addHockeyist(const Game& game, const World& world, const Hockeyist& h, const Hockeyist& next, Samples& samples)
+	{
+		if (h.getType() == GOALIE || h.getState() == RESTING || next.getState() == RESTING || !isClear(game, world, h, next))
+			return;
+
+		if (h.getState() == KNOCKED_DOWN && next.getState() == KNOCKED_DOWN)
+		{
+			// no control at all
+			samples.m_hockeyistFriction.add(h.getSpeedX(), next.getSpeedX());
+			samples.m_hockeyistFriction.add(h.getSpeedY(), next.getSpeedY());
+			return;
+		}
+
+		// new heading is known, acceleration is along it
+		const double cosA   = std::cos(next.getAngle());
+		const double sinA   = std::sin(next.getAngle());
+		const double across = -h.getSpeedX() * sinA + h.getSpeedY() * cosA;
+		samples.m_hockeyistFriction.add(across, -next.getSpeedX() * sinA + next.getSpeedY() * cosA);
+
+		if (h.getState() != ACTIVE || next.getState() != ACTIVE)
+			return;
+
+		const double agility = AttributeCache::compute(h, game).m_agility;
+		const Control control = {h.getSpeedX() * cosA + h.getSpeedY() * sinA, next.getSpeedX() * cosA + next.getSpeedY() * sinA, agility};
+		samples.m_controls.push_back(control);
+
+		samples.m_turn.push_back(std::abs(normalizeAngle(next.getAngle() - h.getAngle())) / (game.getHockeyistTurnAngleFactor() * agility));
+	}
+
+	void addPuck(const Game& game, const World& world, const World& next, Samples& samples)
+	{
+		const Puck& puck     = world.getPuck();
+		const Puck& nextPuck = next.getPuck();
+		if (puck.getOwnerHockeyistId() != -1 || nextPuck.getOwnerHockeyistId() != -1 || !isClear(game, world, puck, nextPuck))
+			return;
+
+		if (toVectorSpeed(puck.getSpeedX(), puck.getSpeedY()) < 1)
+			return;
+
+		samples.m_puckFriction.add(puck.getSpeedX(), nextPuck.getSpeedX());
+		samples.m_puckFriction.add(puck.getSpeedY(), nextPuck.getSpeedY());
+
+		// position moves by the speed before friction
+		const double dx = nextPuck.getX() - puck.getX() - puck.getSpeedX();
+		const double dy = nextPuck.getY() - puck.getY() - puck.getSpeedY();
+		samples.m_puckPathError += dx * dx + dy * dy;
+	}
+
+	void addRecording(const Recording& recording, Samples& samples)
+	{
+		for (size_t i = 0; i + 1 < recording.m_contexts.size(); ++i)
+		{
+			const World& world = recording.m_contexts[i].getWorld();
+			const World& next  = recording.m_contexts[i + 1].getWorld();
+			if (next.getTick() != world.getTick() + 1)
+				continue;
+
+			// goals reset positions
+			if (next.getMyPlayer().isJustMissedGoal() || next.getMyPlayer().isJustScoredGoal())
+				continue;
+
+			for (const Hockeyist& h: world.getHockeyists())
+			{
+				if (const Hockeyist* nextH = findHockeyist(next, h.getId()))
+					addHockeyist(recording.m_game, world, h, *nextH, samples);
+			}
+
+			addPuck(recording.m_game, world, next, samples);
+		}
+	}
+
+	void report(FILE* out, Parameters::Id id, double value, int count, bool isFitted)
+	{
+		const Parameters::Info& info = Parameters::getInfo(id);
+		if (isFitted)
+			std::fprintf(out, "%-26s %.10g   # %d samples\n", info.m_name, value, count);
+		else
+			std::fprintf(out, "# %-24s %.10g   # default, %d samples only\n", info.m_name, info.m_default, count);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::string              outPath;
+	std::vector<std::string> paths;
+
+	bool isValid = true;
+	for (int next = 1; isValid && next < argc; ++next)
+	{
+		const std::string arg = argv[next];
+		if (arg == "--out" && next + 1 < argc)
+			outPath = argv[++next];
+		else if (arg[0] != '-')
+			paths.push_back(arg);
+		else
+			isValid = false;
+	}
+
+	if (!isValid || paths.empty())
+	{
+		std::fprintf(stderr, "usage: %s recording... [--out params]\n", argv[0]);
+		return 1;
+	}
+
+	Samples     samples = Samples();
+	int         ticks   = 0;
+	model::Game recordingGame;   // game constants are the same in all matches
+	for (const std::string& path: paths)
+	{
+		Recording recording;
+		if (!recording.load(path))
+		{
+			std::fprintf(stderr, "can't read recording %s\n", path.c_str());
+			return 2;
+		}
+
+		addRecording(recording, samples);
+		recordingGame = recording.m_game;
+		ticks += static_cast<int>(recording.m_contexts.size());
+	}
+
+	FILE* out = outPath.empty() ? stdout : std::fopen(outPath.c_str(), "w");
+	if (!out)
+	{
+		std::fprintf(stderr, "can't write %s\n", outPath.c_str());
+		return 3;
+	}
+
+	std::fprintf(out, "# fitted to %d ticks of %d recordings\n", ticks, static_cast<int>(paths.size()));
+	std::fprintf(out, "%-26s %d   # frictions below are per tick\n", Parameters::getInfo(Parameters::eCLOSED_FORM_PHYSICS).m_name, 1);
+
+	const LeastSquares& hockeyist = samples.m_hockeyistFriction;
+	const LeastSquares& puck      = samples.m_puckFriction;
+	report(out, Parameters::eHOCKEYIST_FRICTION, hockeyist.getSlope(), hockeyist.m_count, hockeyist.m_count >= kMIN_SAMPLES);
+	report(out, Parameters::ePUCK_FRICTION, puck.getSlope(), puck.m_count, puck.m_count >= kMIN_SAMPLES);
+
+	// control is applied before friction: next speed = friction * (speed + acceleration)
+	const double        friction = hockeyist.m_count >= kMIN_SAMPLES ? hockeyist.getSlope() : Parameters::getInfo(Parameters::eHOCKEYIST_FRICTION).m_default;
+	std::vector<double> speedUp;     // implied acceleration / (game factor * agility)
+	std::vector<double> speedDown;
+	for (const Control& c: samples.m_controls)
+	{
+		const double gain = c.m_nextAlong / friction - c.m_along;
+		if (gain > 0)
+			speedUp.push_back(gain / (recordingGame.getHockeyistSpeedUpFactor() * c.m_agility));
+		else
+			speedDown.push_back(-gain / (recordingGame.getHockeyistSpeedDownFactor() * c.m_agility));
+	}
+
+	const int speedUpCount   = static_cast<int>(speedUp.size());
+	const int speedDownCount = static_cast<int>(speedDown.size());
+	const int turnCount      = static_cast<int>(samples.m_turn.size());
+	report(out, Parameters::eSPEED_UP_SCALE,   speedUpCount   ? getQuantile(speedUp,   kSCALE_QUANTILE) : 0, speedUpCount,   speedUpCount   >= kMIN_SAMPLES);
+	report(out, Parameters::eSPEED_DOWN_SCALE, speedDownCount ? getQuantile(speedDown, kSCALE_QUANTILE) : 0, speedDownCount, speedDownCount >= kMIN_SAMPLES);
+	report(out, Parameters::eTURN_SCALE,       turnCount      ? getQuantile(samples.m_turn,      kSCALE_QUANTILE) : 0, turnCount,      turnCount      >= kMIN_SAMPLES);
+
+	if (puck.m_count > 0)
+		std::fprintf(out, "# free puck position step rms error %.4g\n", std::sqrt(samples.m_puckPathError / (puck.m_count / 2)));
+
+	if (out != stdout)
+		std::fclose(out);
+	return 0;
+}
@@ -0,0 +1,230 @@
+#include "Recording.h"
+#include "../LocalTransport.h"
+#include "../RemoteProcessClient.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+// Game runner stand-in on the same host: serves a recorded game over tcp:PORT, unix:PATH or shm:NAME strictly in
+// lockstep, next PLAYER_CONTEXT only after MOVES of the previous one, and reports the round trip per tick.
+// With --echo it is the client instead, answering every tick with empty moves at once, so serve + echo measures
+// the transport alone and serve + ai the transport plus strategy.
+namespace
+{
+	using namespace model;
+	typedef std::chrono::steady_clock TClock;
+
+	//! listening socket accepting exactly one client
+	int acceptOne(int domain, sockaddr* address, socklen_t addressSize)
+	{
+		const int listener = socket(domain, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		const int yes      = 1;
+		setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+		if (listener < 0 || bind(listener, address, addressSize) != 0 || listen(listener, 1) != 0)
+		{
+			std::perror("listen");
+			std::exit(1);
+		}
+
+		const int descriptor = accept4(listener, NULL, NULL, SOCK_CLOEXEC);
+		close(listener);
+		if (descriptor < 0)
+		{
+			std::perror("accept");
+			std::exit(1);
+		}
+
+		if (domain == AF_INET)
+			setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+		return descriptor;
+	}
+
+	std::unique_ptr<Transport> listenOn(const std::string& address)
+	{
+		if (address.compare(0, 4, "tcp:") == 0)
+		{
+			sockaddr_in inet = sockaddr_in();
+			inet.sin_family      = AF_INET;
+			inet.sin_port        = htons(static_cast<uint16_t>(std::atoi(address.c_str() + 4)));
+			inet.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			return std::unique_ptr<Transport>(new DescriptorTransport(acceptOne(AF_INET, reinterpret_cast<sockaddr*>(&inet), sizeof(inet))));
+		}
+		if (address.compare(0, 5, "unix:") == 0)
+		{
+			sockaddr_un local = sockaddr_un();
+			local.sun_family = AF_UNIX;
+			std::strncpy(local.sun_path, address.c_str() + 5, sizeof(local.sun_path) - 1);
+			unlink(local.sun_path);
+			const int descriptor = acceptOne(AF_UNIX, reinterpret_cast<sockaddr*>(&local), sizeof(local));
+			unlink(local.sun_path);
+			return std::unique_ptr<Transport>(new DescriptorTransport(descriptor));
+		}
+		if (address.compare(0, 4, "shm:") == 0)
+			return std::unique_ptr<Transport>(new ShmTransport(address.substr(4), true));
+
+		return std::unique_ptr<Transport>();
+	}
+
+	std::unique_ptr<Transport> connectTo(const std::string& address)
+	{
+		if (address.compare(0, 4, "tcp:") == 0)
+			return std::unique_ptr<Transport>(new SocketTransport("127.0.0.1", std::atoi(address.c_str() + 4)));
+		if (address.compare(0, 5, "unix:") == 0)
+			return std::unique_ptr<Transport>(new UnixSocketTransport(address.substr(5)));
+		if (address.compare(0, 4, "shm:") == 0)
+			return std::unique_ptr<Transport>(new ShmTransport(address.substr(4), false));
+
+		return std::unique_ptr<Transport>();
+	}
+
+	double getQuantile(const std::vector<double>& sorted, double fraction)
+	{
+		return sorted[std::min(sorted.size() - 1, static_cast<size_t>(fraction * sorted.size()))];
+	}
+
+	int serve(std::unique_ptr<Transport> transport, const Recording& recording, int tickLimit, const std::string& movesPath)
+	{
+		RemoteProcessClient client(std::move(transport));
+		client.readTokenMessage();
+		client.writeTeamSizeMessage(recording.m_teamSize);
+		client.readProtocolVersionMessage();
+		client.writeGameContextMessage(recording.m_game);
+
+		// received moves re-encoded, comparable across transports and runner modes
+		MemoryTransport*    movesTransport = new MemoryTransport();
+		RemoteProcessClient movesWriter{std::unique_ptr<Transport>(movesTransport)};
+
+		const size_t tickCount = tickLimit > 0 ? std::min(recording.m_contexts.size(), static_cast<size_t>(tickLimit)) : recording.m_contexts.size();
+		std::vector<double> roundTrips;
+		roundTrips.reserve(tickCount);
+
+		Moves moves;
+		for (size_t tick = 0; tick < tickCount; ++tick)
+		{
+			const TClock::time_point start = TClock::now();
+			client.writePlayerContextMessage(recording.m_contexts[tick]);
+			if (!client.readMovesMessage(moves))
+			{
+				std::fprintf(stderr, "client left at tick %u\n", static_cast<unsigned>(tick));
+				break;
+			}
+			roundTrips.push_back(std::chrono::duration<double, std::micro>(TClock::now() - start).count());
+
+			movesWriter.writeMovesMessage(moves);
+		}
+		client.writeGameOverMessage();
+
+		if (!movesPath.empty())
+		{
+			FILE* file = std::fopen(movesPath.c_str(), "wb");
+			const std::vector<signed char>& bytes = movesTransport->getOutput();
+			if (!file || (!bytes.empty() && std::fwrite(&bytes[0], 1, bytes.size(), file) != bytes.size()))
+				std::fprintf(stderr, "can't write %s\n", movesPath.c_str());
+			if (file)
+				std::fclose(file);
+		}
+
+		if (roundTrips.empty())
+			return 1;
+
+		double total = 0;
+		for (double t: roundTrips)
+			total += t;
+		std::sort(roundTrips.begin(), roundTrips.end());
+
+		std::printf("ticks %u  round trip us: mean %.1f  p50 %.1f  p90 %.1f  p99 %.1f  max %.1f  total ms %.1f\n",
+			static_cast<unsigned>(roundTrips.size()), total / roundTrips.size(), getQuantile(roundTrips, 0.5),
+			getQuantile(roundTrips, 0.9), getQuantile(roundTrips, 0.99), roundTrips.back(), total / 1000);
+		return 0;
+	}
+
+	int echo(std::unique_ptr<Transport> transport)
+	{
+		RemoteProcessClient client(std::move(transport));
+		client.writeTokenMessage("0000000000000000");
+		const int teamSize = client.readTeamSizeMessage();
+		client.writeProtocolVersionMessage();
+		client.readGameContextMessage();
+
+		const Moves moves(teamSize);
+		for (;;)
+		{
+			std::unique_ptr<PlayerContext> context(client.readPlayerContextMessage());
+			if (!context)
+				break;
+			client.writeMovesMessage(moves);
+		}
+		return 0;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::string address;
+	std::string recordingPath;
+	std::string movesPath;
+	int         tickLimit = 0;
+	bool        isEcho    = false;
+
+	bool isValid = true;
+	for (int next = 1; isValid && next < argc; ++next)
+	{
+		const std::string arg = argv[next];
+		if (arg == "--echo")
+			isEcho = true;
+		else if (arg == "--ticks" && next + 1 < argc)
+			tickLimit = std::atoi(argv[++next]);
+		else if (arg == "--moves" && next + 1 < argc)
+			movesPath = argv[++next];
+		else if (address.empty() && arg.compare(0, 2, "--") != 0)
+			address = arg;
+		else if (recordingPath.empty() && arg.compare(0, 2, "--") != 0)
+			recordingPath = arg;
+		else
+			isValid = false;
+	}
+
+	if (!isValid || address.empty() || isEcho != recordingPath.empty())
+	{
+		std::fprintf(stderr, "usage: %s tcp:PORT|unix:PATH|shm:NAME recorded.bin [--ticks N] [--moves out.bin]\n"
+			"       %s --echo tcp:PORT|unix:PATH|shm:NAME\n", argv[0], argv[0]);
+		return 1;
+	}
+
+	if (isEcho)
+	{
+		std::unique_ptr<Transport> transport = connectTo(address);
+		if (!transport)
+		{
+			std::fprintf(stderr, "unknown address %s\n", address.c_str());
+			return 1;
+		}
+		return echo(std::move(transport));
+	}
+
+	Recording recording;
+	if (!recording.load(recordingPath) || recording.m_contexts.empty())
+	{
+		std::fprintf(stderr, "can't load recording %s\n", recordingPath.c_str());
+		return 1;
+	}
+
+	std::unique_ptr<Transport> transport = listenOn(address);
+	if (!transport)
+	{
+		std::fprintf(stderr, "unknown address %s\n", address.c_str());
+		return 1;
+	}
+	return serve(std::move(transport), recording, tickLimit, movesPath);
+}
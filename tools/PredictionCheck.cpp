@@ -0,0 +1,305 @@
+#include "Recording.h"
+#include "../MyStrategy.h"
+#include "../TeamContext.h"
+#include "../Utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace model;
+
+//! Replays recorded ticks through the strategy's own predictions and compares them with what happened N ticks later.
+//! Only units which neither bounce, get controlled nor get placed (faceoffs) in between are comparable, collisions
+//! and moves of other players are not predicted. Our own active hockeyists are predicted with their recorded move
+//! while it keeps its speed up and heading; other active ones coast (speed up 0) and are reported for reference only.
+class PredictionCheck
+{
+public:
+	enum Category
+	{
+		ePUCK = 0,          //!< free puck, predictPuck()
+		eSLIDING,           //!< knocked down hockeyist, getGhost()
+		eCOASTING,          //!< active hockeyist, getGhost() without speed up
+		eDRIVEN,            //!< our active hockeyist with a recorded move, getGhost() with its speed up
+		eCATEGORY_COUNT
+	};
+
+	struct Errors
+	{
+		std::vector<double> m_position;
+		std::vector<double> m_speed;
+	};
+
+private:
+	static const double kMARGIN;
+	static const double kMAX_TURN;
+
+	TeamContext m_team;
+	MyStrategy  m_strategy;
+
+	const std::vector<unsigned> m_horizons;    //!< ascending
+	std::vector<Errors>         m_errors;      //!< by category, then horizon
+
+	//! what our hockeyist was told on context i, null for opponents or without recorded moves
+	static const Move* getMove(const Recording& r, size_t i, long long id)
+	{
+		if (i >= r.m_moves.size())
+			return nullptr;
+
+		const Hockeyists& own = r.m_contexts[i].getHockeyists();
+		for (size_t j = 0; j < own.size() && j < r.m_moves[i].size(); ++j)
+		{
+			if (own[j].getId() == id)
+				return &r.m_moves[i][j];
+		}
+		return nullptr;
+	}
+
+	//! moves getGhost() follows as long as the angle stays: no action which changes the state
+	static bool isDriven(const Move& move)
+	{
+		return move.getAction() == NONE || move.getAction() == TAKE_PUCK;
+	}
+
+	static Category getCategory(const Recording& r, size_t i, const Hockeyist& h)
+	{
+		if (h.getState() == KNOCKED_DOWN)
+			return eSLIDING;
+
+		const Move* move = getMove(r, i, h.getId());
+		return h.getState() == ACTIVE && move && isDriven(*move) ? eDRIVEN : eCOASTING;
+	}
+
+	void add(Category category, size_t horizon, const Motion& predicted, const Unit& actual)
+	{
+		Errors& e = m_errors[category * m_horizons.size() + horizon];
+		e.m_position.push_back(toVectorSpeed(predicted.m_x - actual.getX(), predicted.m_y - actual.getY()));
+		e.m_speed.push_back(toVectorSpeed(predicted.m_speedX - actual.getSpeedX(), predicted.m_speedY - actual.getSpeedY()));
+	}
+
+	//! how many ticks after first the unit stays clear and in the same category, up to maxTicks
+	unsigned getUntouchedTicks(const Recording& r, size_t first, long long id, unsigned maxTicks) const
+	{
+		const World&     start     = r.m_contexts[first].getWorld();
+		const Hockeyist* startUnit = find_unit(start.getHockeyists(), [id](const Hockeyist& h) { return h.getId() == id; });
+		const Category   category  = startUnit ? getCategory(r, first, *startUnit) : ePUCK;
+		const Move*      startMove = getMove(r, first, id);
+
+		const Unit* previous = nullptr;
+		unsigned    ticks    = 0;
+		for (size_t i = first; i < r.m_contexts.size() && ticks <= maxTicks; ++i, ++ticks)
+		{
+			const World& w = r.m_contexts[i].getWorld();
+			if (w.getTick() != start.getTick() + static_cast<int>(ticks) || w.getMyPlayer().isJustMissedGoal() || w.getMyPlayer().isJustScoredGoal())
+				break;
+
+			const Hockeyist* h    = id == -1 ? nullptr : find_unit(w.getHockeyists(), [id](const Hockeyist& h) { return h.getId() == id; });
+			const Unit*      unit = id == -1 ? static_cast<const Unit*>(&w.getPuck()) : h;
+			if (!unit)
+				break;
+
+			// a step longer than the unit can go is a placement, as after a goal or for the overtime faceoff
+			const double speed = toVectorSpeed(unit->getSpeedX(), unit->getSpeedY());
+			if (previous && unit->getDistanceTo(*previous) > std::max(speed, toVectorSpeed(previous->getSpeedX(), previous->getSpeedY())) + kMARGIN)
+				break;
+			previous = unit;
+
+			if (!isClear(r.m_game, w, *unit, speed + kMARGIN))
+				break;
+
+			if (id == -1)
+			{
+				if (w.getPuck().getOwnerHockeyistId() != -1)
+					break;
+				continue;
+			}
+
+			if (getCategory(r, i, *h) != category || h->getState() == SWINGING || h->getState() == RESTING)
+				break;
+
+			// getGhost() accelerates with the first speed up along the first angle
+			const double turn = h->getAngle() - startUnit->getAngle();
+			if (category == eDRIVEN &&
+				(getMove(r, i, id)->getSpeedUp() != startMove->getSpeedUp() || std::fabs(std::atan2(std::sin(turn), std::cos(turn))) > kMAX_TURN))
+				break;
+		}
+		return ticks == 0 ? 0 : ticks - 1;
+	}
+
+	void add(const Recording& r, size_t first, long long id)
+	{
+		const unsigned untouched = getUntouchedTicks(r, first, id, m_horizons.back());
+		const World&   world     = r.m_contexts[first].getWorld();
+
+		for (size_t k = 0; k < m_horizons.size() && m_horizons[k] <= untouched; ++k)
+		{
+			const World& future = r.m_contexts[first + m_horizons[k]].getWorld();
+			if (id == -1)
+			{
+				add(ePUCK, k, m_strategy.predictPuck(world.getPuck(), m_horizons[k]), future.getPuck());
+				continue;
+			}
+
+			const Hockeyist& h      = *find_unit(world.getHockeyists(),  [id](const Hockeyist& u) { return u.getId() == id; });
+			const Hockeyist& actual = *find_unit(future.getHockeyists(), [id](const Hockeyist& u) { return u.getId() == id; });
+			const Category   category = getCategory(r, first, h);
+			const double     speedUp  = category == eDRIVEN ? getMove(r, first, id)->getSpeedUp() : 0;
+			const UnitState  ghost    = m_strategy.getGhost(h, m_horizons[k], h.getAngle(), speedUp);
+			add(category, k, ghost.getMotion(), actual);
+		}
+	}
+
+public:
+	explicit PredictionCheck(const std::vector<unsigned>& horizons)
+		: m_strategy(m_team)
+		, m_horizons(horizons)
+		, m_errors(eCATEGORY_COUNT * horizons.size())
+	{}
+
+	void setParameters(const Parameters& parameters) { m_team.m_parameters = parameters; }
+
+	const Errors& getErrors(Category category, size_t horizon) const { return m_errors[category * m_horizons.size() + horizon]; }
+
+	void add(const Recording& r)
+	{
+		for (size_t i = 0; i < r.m_contexts.size(); ++i)
+		{
+			const World& world = r.m_contexts[i].getWorld();
+			m_strategy.update(nullptr, &world, &r.m_game, nullptr);
+			m_team.m_attributes.update(world, r.m_game);
+
+			add(r, i, -1);
+			for (const Hockeyist& h: world.getHockeyists())
+			{
+				if (h.getType() != GOALIE && h.getState() != SWINGING && h.getState() != RESTING)
+					add(r, i, h.getId());
+			}
+		}
+	}
+};
+
+const double PredictionCheck::kMARGIN   = 5;
+const double PredictionCheck::kMAX_TURN = 0.01;
+
+namespace
+{
+	const char* kCATEGORY_NAMES[PredictionCheck::eCATEGORY_COUNT] = {"puck", "sliding", "coasting", "driven"};
+
+	double getPercentile(std::vector<double> values, double fraction)
+	{
+		if (values.empty())
+			return 0;
+
+		const size_t n = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+		std::nth_element(values.begin(), values.begin() + n, values.end());
+		return values[n];
+	}
+
+	//! "1,5,10"
+	bool parseHorizons(const std::string& list, std::vector<unsigned>& horizons)
+	{
+		horizons.clear();
+		for (size_t begin = 0; begin <= list.size(); )
+		{
+			const size_t end   = std::min(list.find(',', begin), list.size());
+			const int    value = std::atoi(list.substr(begin, end - begin).c_str());
+			if (value <= 0)
+				return false;
+			horizons.push_back(static_cast<unsigned>(value));
+			begin = end + 1;
+		}
+		std::sort(horizons.begin(), horizons.end());
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<std::string> paths;
+	std::vector<unsigned>    horizons = {1, 5, 10, 20, 40, 80};
+	std::string              parametersPath;
+	double                   maxError    = 0.5;    // p90 position error per tick of horizon, all but coasting
+	int                      minSamples  = 50;     // horizons with less samples aren't checked
+
+	bool isValid = true;
+	for (int next = 1; isValid && next < argc; ++next)
+	{
+		const std::string arg = argv[next];
+		if (arg == "--horizons" && next + 1 < argc)
+			isValid = parseHorizons(argv[++next], horizons);
+		else if (arg == "--params" && next + 1 < argc)
+			parametersPath = argv[++next];
+		else if (arg == "--max-error" && next + 1 < argc)
+			maxError = std::atof(argv[++next]);
+		else if (arg == "--min-samples" && next + 1 < argc)
+			minSamples = std::atoi(argv[++next]);
+		else if (arg[0] != '-')
+			paths.push_back(arg);
+		else
+			isValid = false;
+	}
+
+	if (!isValid || paths.empty())
+	{
+		std::fprintf(stderr, "usage: %s recording... [--horizons 1,5,10] [--params file] [--max-error units per tick] [--min-samples N]\n", argv[0]);
+		return 1;
+	}
+
+	PredictionCheck check(horizons);
+	if (!parametersPath.empty())
+	{
+		Parameters  parameters;
+		std::string error;
+		if (!parameters.load(parametersPath, error))
+		{
+			std::fprintf(stderr, "%s\n", error.c_str());
+			return 2;
+		}
+		check.setParameters(parameters);
+	}
+
+	for (const std::string& path: paths)
+	{
+		Recording recording;
+		if (!recording.load(path))
+		{
+			std::fprintf(stderr, "can't read recording %s\n", path.c_str());
+			return 2;
+		}
+		check.add(recording);
+	}
+
+	int failures = 0;
+	std::printf("%-9s %5s %8s %9s %9s %9s %9s %9s %9s  %s\n", "unit", "ticks", "samples", "pos_p50", "pos_p90", "pos_p99", "pos_max", "speed_p50", "speed_p90", "limit");
+	for (int c = 0; c < PredictionCheck::eCATEGORY_COUNT; ++c)
+	{
+		const PredictionCheck::Category category = static_cast<PredictionCheck::Category>(c);
+		for (size_t k = 0; k < horizons.size(); ++k)
+		{
+			const PredictionCheck::Errors& e = check.getErrors(category, k);
+			const double p90       = getPercentile(e.m_position, 0.9);
+			const bool   isChecked = category != PredictionCheck::eCOASTING && static_cast<int>(e.m_position.size()) >= minSamples;
+			const double limit     = maxError * horizons[k];
+			const bool   isFailed  = isChecked && p90 > limit;
+			failures += isFailed ? 1 : 0;
+
+			std::printf("%-9s %5u %8u %9.3f %9.3f %9.3f %9.3f %9.4f %9.4f  ", kCATEGORY_NAMES[c], horizons[k], static_cast<unsigned>(e.m_position.size()),
+				getPercentile(e.m_position, 0.5), p90, getPercentile(e.m_position, 0.99),
+				e.m_position.empty() ? 0 : *std::max_element(e.m_position.begin(), e.m_position.end()),
+				getPercentile(e.m_speed, 0.5), getPercentile(e.m_speed, 0.9));
+
+			if (isChecked)
+				std::printf("%.3f %s\n", limit, isFailed ? "FAILED" : "ok");
+			else
+				std::printf("-\n");
+		}
+	}
+
+	if (failures)
+		std::printf("%d horizons over the limit\n", failures);
+	return failures ? 3 : 0;
+}
@@ -0,0 +1,175 @@
+#include "Bench.h"
+#include "Recording.h"
+#include "WorldFactory.h"
+#include "../RemoteProcessClient.h"
+
+#include <cstdio>
+
+using namespace model;
+
+namespace
+{
+	//! protocol client over in-memory stream, keeping access to the stream
+	struct MemoryClient
+	{
+		MemoryTransport*    m_transport;
+		RemoteProcessClient m_client;
+
+		MemoryClient() : m_transport(new MemoryTransport()), m_client(std::unique_ptr<Transport>(m_transport)) {}
+	};
+
+	std::vector<PlayerContext> makeContexts(const Game& game, int count, unsigned seed)
+	{
+		std::vector<PlayerContext> contexts;
+		for (const World& world: WorldFactory::makeCorpus(game, count, seed))
+		{
+			Hockeyists mine;
+			for (const Hockeyist& h: world.getHockeyists())
+			{
+				if (h.isTeammate() && h.getType() != GOALIE)
+					mine.push_back(h);
+			}
+
+			contexts.push_back(PlayerContext(mine, world));
+		}
+
+		return contexts;
+	}
+
+	Moves makeMoves(size_t count)
+	{
+		Moves moves(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			moves[i].setSpeedUp(1.0);
+			moves[i].setTurn(0.1 * i);
+			moves[i].setAction(i % 2 ? STRIKE : TAKE_PUCK);
+		}
+		return moves;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Bench::Options options;
+	std::string    corpusPath;
+
+	bool isValid = true;
+	for (int next = 1; isValid && next < argc; ++next)
+	{
+		const std::string arg = argv[next];
+		if (Bench::parseOption(argc, argv, next, options))
+			continue;
+		else if (arg == "--corpus" && next + 1 < argc)
+			corpusPath = argv[++next];
+		else
+			isValid = false;
+	}
+
+	if (!isValid)
+	{
+		std::fprintf(stderr, "usage: %s [--samples N] [--ops N] [--filter name] [--corpus recorded.bin]\n", argv[0]);
+		return 1;
+	}
+
+	Recording recording;
+	if (!corpusPath.empty())
+	{
+		if (!recording.load(corpusPath) || recording.m_contexts.empty())
+		{
+			std::fprintf(stderr, "can't load recording %s\n", corpusPath.c_str());
+			return 2;
+		}
+	}
+	else
+	{
+		recording.m_teamSize = 3;
+		recording.m_game     = WorldFactory::makeGame();
+		recording.m_contexts = makeContexts(recording.m_game, 256, 1);
+	}
+
+	const std::vector<PlayerContext>& contexts = recording.m_contexts;
+	const Moves                       moves    = makeMoves(recording.m_teamSize);
+
+	// encoded frames for decoding benchmarks
+	MemoryClient encoder;
+	for (const PlayerContext& context: contexts)
+		encoder.m_client.writePlayerContextMessage(context);
+	const std::vector<signed char> contextStream = encoder.m_transport->getOutput();
+	encoder.m_transport->clearOutput();
+
+	encoder.m_client.writeMovesMessage(moves);
+	const std::vector<signed char> movesStream = encoder.m_transport->getOutput();
+	encoder.m_transport->clearOutput();
+
+	std::printf("frames: %u, PLAYER_CONTEXT avg %.0f bytes, MOVES_MESSAGE %u bytes\n", static_cast<unsigned>(contexts.size()),
+		static_cast<double>(contextStream.size()) / contexts.size(), static_cast<unsigned>(movesStream.size()));
+
+	const unsigned ops = options.m_opsPerSample;
+	Bench::printHeader();
+
+	if (options.isSelected("encode PLAYER_CONTEXT"))
+	{
+		MemoryClient client;
+		Bench::print(Bench::run("encode PLAYER_CONTEXT", options, ops, [&](unsigned i)
+		{
+			if (i % contexts.size() == 0)
+				client.m_transport->clearOutput();
+			client.m_client.writePlayerContextMessage(contexts[i % contexts.size()]);
+		}));
+	}
+
+	if (options.isSelected("decode PLAYER_CONTEXT"))
+	{
+		MemoryClient client;
+		client.m_transport->setInput(contextStream);
+		Bench::print(Bench::run("decode PLAYER_CONTEXT", options, ops, [&](unsigned)
+		{
+			if (client.m_transport->isInputEnd())
+				client.m_transport->rewind();
+
+			std::unique_ptr<PlayerContext> context(client.m_client.readPlayerContextMessage());
+			Bench::doNotOptimize(context);
+		}));
+	}
+
+	if (options.isSelected("decode PLAYER_CONTEXT in place"))
+	{
+		MemoryClient  client;
+		PlayerContext context;
+		client.m_transport->setInput(contextStream);
+		Bench::print(Bench::run("decode PLAYER_CONTEXT in place", options, ops, [&](unsigned)
+		{
+			if (client.m_transport->isInputEnd())
+				client.m_transport->rewind();
+
+			Bench::doNotOptimize(client.m_client.readPlayerContextMessage(context));
+		}));
+	}
+
+	if (options.isSelected("encode MOVES_MESSAGE"))
+	{
+		MemoryClient client;
+		Bench::print(Bench::run("encode MOVES_MESSAGE", options, ops, [&](unsigned i)
+		{
+			if (i % 1024 == 0)
+				client.m_transport->clearOutput();
+			client.m_client.writeMovesMessage(moves);
+		}));
+	}
+
+	if (options.isSelected("decode MOVES_MESSAGE"))
+	{
+		MemoryClient      client;
+		Moves decoded;
+		client.m_transport->setInput(movesStream);
+		Bench::print(Bench::run("decode MOVES_MESSAGE", options, ops, [&](unsigned)
+		{
+			client.m_transport->rewind();
+			client.m_client.readMovesMessage(decoded);
+			Bench::doNotOptimize(decoded);
+		}));
+	}
+
+	return 0;
+}
@@ -0,0 +1,61 @@
+#include "Recording.h"
+#include "../RemoteProcessClient.h"
+#include "../Utils.h"
+
+using namespace model;
+
+bool Recording::load(const std::string& path)
+{
+	const std::vector<signed char> bytes = readFileBytes(path);
+	if (bytes.empty())
+		return false;
+
+	MemoryTransport*           transport = new MemoryTransport(bytes);
+	std::unique_ptr<Transport> owner(transport);
+	RemoteProcessClient        client(std::move(owner));
+
+	m_teamSize = client.readTeamSizeMessage();
+	m_game     = client.readGameContextMessage();
+	m_contexts.clear();
+
+	while (!transport->isInputEnd())
+	{
+		std::unique_ptr<PlayerContext> context(client.readPlayerContextMessage());
+		if (!context)
+			break;
+
+		m_contexts.push_back(*context);
+	}
+
+	m_moves.clear();
+	const std::vector<signed char> sentBytes = readFileBytes(path + ".sent");
+	if (sentBytes.empty())
+		return true;
+
+	MemoryTransport*           sentTransport = new MemoryTransport(sentBytes);
+	std::unique_ptr<Transport> sentOwner(sentTransport);
+	RemoteProcessClient        sentClient(std::move(sentOwner));
+	sentClient.readTokenMessage();
+	sentClient.readProtocolVersionMessage();
+
+	Moves moves;
+	while (!sentTransport->isInputEnd() && sentClient.readMovesMessage(moves))
+		m_moves.push_back(moves);
+
+	return true;
+}
+
+bool isClear(const Game& game, const World& world, const Unit& unit, double reach)
+{
+	const double r = unit.getRadius() + reach;
+	if (unit.getX() - r < game.getRinkLeft() || unit.getX() + r > game.getRinkRight() ||
+		unit.getY() - r < game.getRinkTop()  || unit.getY() + r > game.getRinkBottom())
+		return false;
+
+	for (const Hockeyist& h: world.getHockeyists())
+	{
+		if (h.getId() != unit.getId() && unit.getDistanceTo(h) < r + h.getRadius() + toVectorSpeed(h.getSpeedX(), h.getSpeedY()))
+			return false;
+	}
+	return true;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#ifndef _RECORDING_H_
+#define _RECORDING_H_
+
+#include "../model/Game.h"
+#include "../model/Move.h"
+#include "../model/PlayerContext.h"
+#include <string>
+#include <vector>
+
+//! Game stream recorded by the runner with --record: team size, game context and player context of every tick,
+//! and our answers to them from the .sent file next to it
+struct Recording
+{
+	int                               m_teamSize;
+	model::Game                       m_game;
+	std::vector<model::PlayerContext> m_contexts;
+	std::vector<model::Moves>         m_moves;      //!< by context, then as its getHockeyists(); empty without .sent file
+
+	Recording() : m_teamSize(0) {}
+
+	//! false if file is missing or empty, a missing .sent file only leaves m_moves empty; a stream cut in the middle of a frame terminates the process (as the protocol client does)
+	bool load(const std::string& path);
+};
+
+//! no wall and no other hockeyist within reach of unit's edge, so nothing to bounce off
+bool isClear(const model::Game& game, const model::World& world, const model::Unit& unit, double reach);
+
+#endif
@@ -0,0 +1,668 @@
+#include "Simulator.h"
+#include "WorldFactory.h"
+#include "../Utils.h"
+
+using namespace model;
+
+namespace
+{
+	// not in Game, approximated from real matches
+	static const double kHOCKEYIST_FRICTION = 0.98;
+	static const double kPUCK_FRICTION      = 0.999;
+	static const double kHOCKEYIST_BOUNCE   = 0.25;   // restitution for walls and hockeyist collisions
+	static const double kPUCK_BOUNCE        = 0.75;
+	static const double kPUCK_SPEED_PENALTY = 0.01;   // faster puck is harder to handle, per unit of relative speed
+
+	inline double clamp(double value, double limit) { return std::max(-limit, std::min(limit, value)); }
+
+	inline double normalizeAngle(double angle)
+	{
+		while (angle > PI)
+			angle -= 2 * PI;
+		while (angle < -PI)
+			angle += 2 * PI;
+		return angle;
+	}
+}
+
+Simulator::Simulator(const Game& game, const Options& options)
+	: m_game(game)
+	, m_options(options)
+	, m_random(options.m_seed)
+	, m_tick(0)
+	, m_restTicks(0)
+	, m_lastScorer(-1)
+	, m_isOvertime(false)
+{
+	m_goals[kLEFT] = m_goals[kRIGHT] = 0;
+	m_puck = PuckBody();
+}
+
+double Simulator::getEffectiveness(const Body& b) const
+{
+	const double zero = m_game.getZeroStaminaHockeyistEffectivenessFactor();
+	return zero + (1 - zero) * b.m_stamina / m_game.getHockeyistMaxStamina();
+}
+
+double Simulator::getHandling(const Body& b) const
+{
+	return std::max(b.m_dexterity, b.m_agility) / 100.0 * getEffectiveness(b);
+}
+
+double Simulator::clampChance(double chance) const
+{
+	return std::max(m_game.getMinActionChance(), std::min(m_game.getMaxActionChance(), chance));
+}
+
+bool Simulator::isInStickReach(const Body& b, double x, double y) const
+{
+	const double angle = normalizeAngle(std::atan2(y - b.m_y, x - b.m_x) - b.m_angle);
+	return toVectorSpeed(x - b.m_x, y - b.m_y) < m_game.getStickLength() && std::abs(angle) < m_game.getStickSector() / 2;
+}
+
+Simulator::Body* Simulator::findBody(long long id)
+{
+	for (Body& b: m_bodies)
+	{
+		if (b.m_id == id)
+			return &b;
+	}
+	return nullptr;
+}
+
+void Simulator::createTeams()
+{
+	std::uniform_int_distribution<int> attribute(m_game.getMinRandomHockeyistParameter(), m_game.getMaxRandomHockeyistParameter());
+
+	m_bodies.clear();
+	long long id = 1;
+	for (int team = kLEFT; team <= kRIGHT; ++team)
+	{
+		const int count = m_options.m_teamSize + (m_options.m_hasGoalies ? 1 : 0);
+		for (int index = 0; index < count; ++index)
+		{
+			Body b = Body();
+			b.m_id             = id++;
+			b.m_team           = team;
+			b.m_index          = index;
+			b.m_isGoalie       = index == m_options.m_teamSize;
+			b.m_strength       = b.m_isGoalie ? 100 : attribute(m_random);
+			b.m_endurance      = b.m_isGoalie ? 100 : attribute(m_random);
+			b.m_dexterity      = b.m_isGoalie ? 100 : attribute(m_random);
+			b.m_agility        = b.m_isGoalie ? 100 : attribute(m_random);
+			b.m_stamina        = m_game.getHockeyistMaxStamina();
+			b.m_lastAction     = NONE;
+			b.m_lastActionTick = -1;
+			m_bodies.push_back(b);
+		}
+	}
+}
+
+void Simulator::kickOff()
+{
+	const double centerX = (m_game.getRinkLeft() + m_game.getRinkRight()) / 2;
+	const double centerY = (m_game.getRinkTop() + m_game.getRinkBottom()) / 2;
+	const double height  = m_game.getRinkBottom() - m_game.getRinkTop();
+	const double radius  = WorldFactory::kHOCKEYIST_RADIUS;
+
+	for (Body& b: m_bodies)
+	{
+		const double side = b.m_team == kLEFT ? -1 : 1;
+		if (b.m_isGoalie)
+		{
+			b.m_x = b.m_team == kLEFT ? m_game.getRinkLeft() + radius : m_game.getRinkRight() - radius;
+			b.m_y = centerY;
+		}
+		else
+		{
+			b.m_x = centerX + side * (200 + 80 * (b.m_index % 2));
+			b.m_y = m_game.getRinkTop() + height * (b.m_index + 1) / (m_options.m_teamSize + 1);
+		}
+
+		b.m_speedX = b.m_speedY = b.m_angularSpeed = 0;
+		b.m_angle          = b.m_team == kLEFT ? 0 : PI;
+		b.m_state          = ACTIVE;
+		b.m_knockdownTicks = 0;
+		b.m_cooldownTicks  = 0;
+		b.m_swingTicks     = 0;
+	}
+
+	m_puck.m_x         = centerX;
+	m_puck.m_y         = centerY;
+	m_puck.m_speedX    = m_puck.m_speedY = 0;
+	m_puck.m_ownerId   = -1;
+	m_puck.m_ownerTeam = -1;
+}
+
+World Simulator::makeWorld(int team) const
+{
+	const double netTop    = m_game.getGoalNetTop();
+	const double netBottom = m_game.getGoalNetTop() + m_game.getGoalNetHeight();
+	const double netWidth  = m_game.getGoalNetWidth();
+	const double left      = m_game.getRinkLeft();
+	const double right     = m_game.getRinkRight();
+	const bool   isRest    = m_restTicks > 0;
+
+	Players players;
+	players.push_back(Player(kLEFT + 1, team == kLEFT, team == kLEFT ? "me" : "opponent", m_goals[kLEFT], false,
+		netTop, left - netWidth, netBottom, left, left, left - netWidth, isRest && m_lastScorer == kLEFT, isRest && m_lastScorer == kRIGHT));
+	players.push_back(Player(kRIGHT + 1, team == kRIGHT, team == kRIGHT ? "me" : "opponent", m_goals[kRIGHT], false,
+		netTop, right, netBottom, right + netWidth, right, right + netWidth, isRest && m_lastScorer == kRIGHT, isRest && m_lastScorer == kLEFT));
+
+	Hockeyists hockeyists;
+	for (const Body& b: m_bodies)
+	{
+		hockeyists.push_back(Hockeyist(b.m_id, b.m_team + 1, b.m_index, WorldFactory::kHOCKEYIST_MASS, WorldFactory::kHOCKEYIST_RADIUS,
+			b.m_x, b.m_y, b.m_speedX, b.m_speedY, b.m_angle, b.m_angularSpeed, b.m_team == team, b.m_isGoalie ? GOALIE : RANDOM,
+			b.m_strength, b.m_endurance, b.m_dexterity, b.m_agility, b.m_stamina, b.m_state, b.m_index,
+			b.m_knockdownTicks, b.m_cooldownTicks, b.m_swingTicks, b.m_lastAction, b.m_lastActionTick));
+	}
+
+	const Puck puck = Puck(WorldFactory::kPUCK_ID, WorldFactory::kPUCK_MASS, WorldFactory::kPUCK_RADIUS, m_puck.m_x, m_puck.m_y,
+		m_puck.m_speedX, m_puck.m_speedY, m_puck.m_ownerId, m_puck.m_ownerTeam == -1 ? -1 : m_puck.m_ownerTeam + 1);
+
+	const int tickCount = m_game.getTickCount() + (m_isOvertime ? m_game.getOvertimeTickCount() : 0);
+	return World(m_tick, tickCount, m_game.getWorldWidth(), m_game.getWorldHeight(), players, hockeyists, puck);
+}
+
+void Simulator::loosePuck(Body& owner, int cooldown)
+{
+	if (m_puck.m_ownerId != owner.m_id)
+		return;
+
+	m_puck.m_ownerId     = -1;
+	m_puck.m_ownerTeam   = -1;
+	owner.m_cooldownTicks = std::max(owner.m_cooldownTicks, cooldown);
+}
+
+void Simulator::takePuck(Body& b)
+{
+	if (m_puck.m_ownerId == b.m_id || !isInStickReach(b, m_puck.m_x, m_puck.m_y))
+		return;
+
+	Body* owner = m_puck.m_ownerId == -1 ? nullptr : findBody(m_puck.m_ownerId);
+	const double relativeSpeed = toVectorSpeed(m_puck.m_speedX - b.m_speedX, m_puck.m_speedY - b.m_speedY);
+	const double chance = owner
+		? clampChance(m_game.getTakePuckAwayBaseChance() + getHandling(b) - getStrength(*owner))
+		: clampChance(m_game.getPickUpPuckBaseChance() + getHandling(b) - 1.0 - relativeSpeed * kPUCK_SPEED_PENALTY);
+
+	if (!isChance(chance))
+		return;
+
+	if (owner)
+		loosePuck(*owner, m_game.getActionCooldownTicksAfterLosingPuck());
+
+	m_puck.m_ownerId   = b.m_id;
+	m_puck.m_ownerTeam = b.m_team;
+}
+
+void Simulator::strike(Body& b)
+{
+	const double power = m_game.getStrikePowerBaseFactor() + m_game.getStrikePowerGrowthFactor() * std::min(b.m_swingTicks, m_game.getMaxEffectiveSwingTicks());
+	std::normal_distribution<double> deviation(0, m_game.getStrikeAngleDeviation());
+
+	// puck first: owner always hits it, others need luck
+	bool isPuckHit = m_puck.m_ownerId == b.m_id;
+	if (!isPuckHit && isInStickReach(b, m_puck.m_x, m_puck.m_y))
+	{
+		const double relativeSpeed = toVectorSpeed(m_puck.m_speedX - b.m_speedX, m_puck.m_speedY - b.m_speedY);
+		isPuckHit = isChance(clampChance(m_game.getStrikePuckBaseChance() + getHandling(b) - 1.0 - relativeSpeed * kPUCK_SPEED_PENALTY));
+		if (isPuckHit && m_puck.m_ownerId != -1)
+			loosePuck(*findBody(m_puck.m_ownerId), m_game.getActionCooldownTicksAfterLosingPuck());
+	}
+
+	if (isPuckHit)
+	{
+		const double angle = b.m_angle + deviation(m_random);
+		const double speed = power * m_game.getStruckPuckInitialSpeedFactor();
+		m_puck.m_speedX    = b.m_speedX + std::cos(angle) * speed;
+		m_puck.m_speedY    = b.m_speedY + std::sin(angle) * speed;
+		m_puck.m_ownerId   = -1;
+		m_puck.m_ownerTeam = -1;
+	}
+
+	for (Body& victim: m_bodies)
+	{
+		if (victim.m_id == b.m_id || victim.m_isGoalie || victim.m_state == KNOCKED_DOWN || !isInStickReach(b, victim.m_x, victim.m_y))
+			continue;
+
+		const double chance = clampChance(m_game.getKnockdownChanceFactor() * power * getStrength(b) / std::max(getAgility(victim), 0.01));
+		if (!isChance(chance))
+			continue;
+
+		const double angle = std::atan2(victim.m_y - b.m_y, victim.m_x - b.m_x);
+		victim.m_speedX        += std::cos(angle) * power * m_game.getStruckHockeyistInitialSpeedFactor();
+		victim.m_speedY        += std::sin(angle) * power * m_game.getStruckHockeyistInitialSpeedFactor();
+		victim.m_state          = KNOCKED_DOWN;
+		victim.m_knockdownTicks = static_cast<int>(m_game.getKnockdownTicksFactor() * power);
+		victim.m_swingTicks     = 0;
+		loosePuck(victim, 0);
+	}
+
+	b.m_stamina      -= m_game.getStrikeStaminaBaseCost() + m_game.getStrikeStaminaCostGrowthFactor() * b.m_swingTicks;
+	b.m_state         = ACTIVE;
+	b.m_swingTicks    = 0;
+	b.m_cooldownTicks = m_game.getDefaultActionCooldownTicks();
+}
+
+void Simulator::pass(Body& b, const Move& move)
+{
+	std::normal_distribution<double> deviation(0, m_game.getPassAngleDeviation());
+
+	const double power = std::max(0.0, std::min(1.0, move.getPassPower()));
+	const double angle = b.m_angle + clamp(move.getPassAngle(), m_game.getPassSector() / 2) + deviation(m_random);
+	const double speed = power * m_game.getPassPowerFactor() * m_game.getStruckPuckInitialSpeedFactor();
+
+	m_puck.m_speedX    = b.m_speedX + std::cos(angle) * speed;
+	m_puck.m_speedY    = b.m_speedY + std::sin(angle) * speed;
+	m_puck.m_ownerId   = -1;
+	m_puck.m_ownerTeam = -1;
+
+	b.m_stamina      -= m_game.getPassStaminaCost();
+	b.m_cooldownTicks = m_game.getDefaultActionCooldownTicks();
+}
+
+void Simulator::applyMove(Body& b, const Move& move)
+{
+	if (b.m_state == KNOCKED_DOWN)
+		return;
+
+	// swinging hockeyist can't move on its own
+	if (b.m_state != SWINGING)
+	{
+		const double agility = getAgility(b);
+		const double turn    = clamp(move.getTurn(), m_game.getHockeyistTurnAngleFactor() * agility);
+		const double speedUp = std::max(-1.0, std::min(1.0, move.getSpeedUp()));
+		const double factor  = speedUp > 0 ? m_game.getHockeyistSpeedUpFactor() : m_game.getHockeyistSpeedDownFactor();
+
+		b.m_angle         = normalizeAngle(b.m_angle + turn);
+		b.m_angularSpeed  = turn;
+		b.m_speedX       += std::cos(b.m_angle) * speedUp * factor * agility;
+		b.m_speedY       += std::sin(b.m_angle) * speedUp * factor * agility;
+		b.m_stamina      -= std::abs(speedUp) * m_game.getSpeedUpStaminaCostFactor()
+			+ std::abs(turn) / m_game.getHockeyistTurnAngleFactor() * m_game.getTurnStaminaCostFactor();
+	}
+
+	if (b.m_cooldownTicks > 0 || move.getAction() == NONE)
+		return;
+
+	const ActionType action = move.getAction();
+	switch (action)
+	{
+	case TAKE_PUCK:
+		if (b.m_state != ACTIVE)
+			return;
+		takePuck(b);
+		b.m_stamina      -= m_game.getTakePuckStaminaCost();
+		b.m_cooldownTicks = m_game.getDefaultActionCooldownTicks();
+		break;
+
+	case SWING:
+		if (b.m_state != ACTIVE)
+			return;
+		b.m_state         = SWINGING;
+		b.m_swingTicks    = 0;
+		b.m_stamina      -= m_game.getSwingStaminaCost();
+		b.m_cooldownTicks = m_game.getSwingActionCooldownTicks();
+		break;
+
+	case STRIKE:
+		strike(b);
+		break;
+
+	case CANCEL_STRIKE:
+		if (b.m_state != SWINGING)
+			return;
+		b.m_state         = ACTIVE;
+		b.m_swingTicks    = 0;
+		b.m_stamina      -= m_game.getCancelStrikeStaminaCost();
+		b.m_cooldownTicks = m_game.getCancelStrikeActionCooldownTicks();
+		break;
+
+	case PASS:
+		if (b.m_state != ACTIVE || m_puck.m_ownerId != b.m_id)
+			return;
+		pass(b, move);
+		break;
+
+	default:
+		return;
+	}
+
+	b.m_lastAction     = action;
+	b.m_lastActionTick = m_tick;
+}
+
+void Simulator::moveGoalies()
+{
+	const double radius = WorldFactory::kHOCKEYIST_RADIUS;
+	const double top    = m_game.getGoalNetTop() + radius;
+	const double bottom = m_game.getGoalNetTop() + m_game.getGoalNetHeight() - radius;
+
+	for (Body& b: m_bodies)
+	{
+		if (!b.m_isGoalie)
+			continue;
+
+		const double targetY = std::max(top, std::min(bottom, m_puck.m_y));
+		b.m_speedY = clamp(targetY - b.m_y, m_game.getGoalieMaxSpeed());
+		b.m_y     += b.m_speedY;
+	}
+}
+
+void Simulator::moveBodies()
+{
+	const double radius = WorldFactory::kHOCKEYIST_RADIUS;
+	for (Body& b: m_bodies)
+	{
+		if (b.m_isGoalie)
+			continue;
+
+		const double speed = toVectorSpeed(b.m_speedX, b.m_speedY);
+		if (speed > m_game.getHockeyistMaxSpeed())
+		{
+			b.m_speedX *= m_game.getHockeyistMaxSpeed() / speed;
+			b.m_speedY *= m_game.getHockeyistMaxSpeed() / speed;
+		}
+
+		b.m_x      += b.m_speedX;
+		b.m_y      += b.m_speedY;
+		b.m_speedX *= kHOCKEYIST_FRICTION;
+		b.m_speedY *= kHOCKEYIST_FRICTION;
+
+		if (b.m_x < m_game.getRinkLeft() + radius)   { b.m_x = m_game.getRinkLeft() + radius;   b.m_speedX = -b.m_speedX * kHOCKEYIST_BOUNCE; }
+		if (b.m_x > m_game.getRinkRight() - radius)  { b.m_x = m_game.getRinkRight() - radius;  b.m_speedX = -b.m_speedX * kHOCKEYIST_BOUNCE; }
+		if (b.m_y < m_game.getRinkTop() + radius)    { b.m_y = m_game.getRinkTop() + radius;    b.m_speedY = -b.m_speedY * kHOCKEYIST_BOUNCE; }
+		if (b.m_y > m_game.getRinkBottom() - radius) { b.m_y = m_game.getRinkBottom() - radius; b.m_speedY = -b.m_speedY * kHOCKEYIST_BOUNCE; }
+	}
+}
+
+void Simulator::collide()
+{
+	const double minDistance = 2 * WorldFactory::kHOCKEYIST_RADIUS;
+	for (size_t i = 0; i < m_bodies.size(); ++i)
+	{
+		for (size_t j = i + 1; j < m_bodies.size(); ++j)
+		{
+			Body& a = m_bodies[i];
+			Body& b = m_bodies[j];
+			const double dx = b.m_x - a.m_x;
+			const double dy = b.m_y - a.m_y;
+			const double d  = toVectorSpeed(dx, dy);
+			if (d >= minDistance || d == 0 || (a.m_isGoalie && b.m_isGoalie))
+				continue;
+
+			// goalies are immovable
+			const double nx      = dx / d;
+			const double ny      = dy / d;
+			const double overlap = minDistance - d;
+			const double shareA  = a.m_isGoalie ? 0 : b.m_isGoalie ? 1 : 0.5;
+			const double shareB  = 1 - shareA;
+			a.m_x -= nx * overlap * shareA;
+			a.m_y -= ny * overlap * shareA;
+			b.m_x += nx * overlap * shareB;
+			b.m_y += ny * overlap * shareB;
+
+			const double approach = (b.m_speedX - a.m_speedX) * nx + (b.m_speedY - a.m_speedY) * ny;
+			if (approach >= 0)
+				continue;
+
+			const double impulse = -(1 + kHOCKEYIST_BOUNCE) * approach;
+			a.m_speedX -= nx * impulse * shareA;
+			a.m_speedY -= ny * impulse * shareA;
+			b.m_speedX += nx * impulse * shareB;
+			b.m_speedY += ny * impulse * shareB;
+		}
+	}
+}
+
+void Simulator::movePuck()
+{
+	if (m_puck.m_ownerId != -1)
+	{
+		const Body* owner = findBody(m_puck.m_ownerId);
+		m_puck.m_x      = owner->m_x + std::cos(owner->m_angle) * m_game.getPuckBindingRange();
+		m_puck.m_y      = owner->m_y + std::sin(owner->m_angle) * m_game.getPuckBindingRange();
+		m_puck.m_speedX = owner->m_speedX;
+		m_puck.m_speedY = owner->m_speedY;
+		return;
+	}
+
+	const double radius = WorldFactory::kPUCK_RADIUS;
+	m_puck.m_x      += m_puck.m_speedX;
+	m_puck.m_y      += m_puck.m_speedY;
+	m_puck.m_speedX *= kPUCK_FRICTION;
+	m_puck.m_speedY *= kPUCK_FRICTION;
+
+	// bounce off hockeyists, goalies save this way
+	for (const Body& b: m_bodies)
+	{
+		const double dx = m_puck.m_x - b.m_x;
+		const double dy = m_puck.m_y - b.m_y;
+		const double d  = toVectorSpeed(dx, dy);
+		const double minDistance = radius + WorldFactory::kHOCKEYIST_RADIUS;
+		if (d >= minDistance || d == 0)
+			continue;
+
+		const double nx = dx / d;
+		const double ny = dy / d;
+		m_puck.m_x = b.m_x + nx * minDistance;
+		m_puck.m_y = b.m_y + ny * minDistance;
+
+		const double approach = (m_puck.m_speedX - b.m_speedX) * nx + (m_puck.m_speedY - b.m_speedY) * ny;
+		if (approach < 0)
+		{
+			m_puck.m_speedX -= nx * approach * (1 + kPUCK_BOUNCE);
+			m_puck.m_speedY -= ny * approach * (1 + kPUCK_BOUNCE);
+		}
+	}
+
+	// net front is open between net top and bottom
+	const bool isInNetSpan = m_puck.m_y > m_game.getGoalNetTop() && m_puck.m_y < m_game.getGoalNetTop() + m_game.getGoalNetHeight();
+	if (isInNetSpan && m_puck.m_x < m_game.getRinkLeft())
+		return scoreGoal(kRIGHT);
+	if (isInNetSpan && m_puck.m_x > m_game.getRinkRight())
+		return scoreGoal(kLEFT);
+
+	if (!isInNetSpan && m_puck.m_x < m_game.getRinkLeft() + radius)  { m_puck.m_x = m_game.getRinkLeft() + radius;   m_puck.m_speedX = -m_puck.m_speedX * kPUCK_BOUNCE; }
+	if (!isInNetSpan && m_puck.m_x > m_game.getRinkRight() - radius) { m_puck.m_x = m_game.getRinkRight() - radius;  m_puck.m_speedX = -m_puck.m_speedX * kPUCK_BOUNCE; }
+	if (m_puck.m_y < m_game.getRinkTop() + radius)                    { m_puck.m_y = m_game.getRinkTop() + radius;    m_puck.m_speedY = -m_puck.m_speedY * kPUCK_BOUNCE; }
+	if (m_puck.m_y > m_game.getRinkBottom() - radius)                 { m_puck.m_y = m_game.getRinkBottom() - radius; m_puck.m_speedY = -m_puck.m_speedY * kPUCK_BOUNCE; }
+}
+
+void Simulator::scoreGoal(int team)
+{
+	++m_goals[team];
+	m_lastScorer = team;
+	m_restTicks  = m_game.getAfterGoalStateTickCount();
+
+	// puck stays in the net until kick-off
+	m_puck.m_speedX    = m_puck.m_speedY = 0;
+	m_puck.m_ownerId   = -1;
+	m_puck.m_ownerTeam = -1;
+}
+
+void Simulator::updateTimers()
+{
+	const double maxStamina = m_game.getHockeyistMaxStamina();
+	for (Body& b: m_bodies)
+	{
+		if (b.m_cooldownTicks > 0)
+			--b.m_cooldownTicks;
+
+		if (b.m_state == KNOCKED_DOWN && --b.m_knockdownTicks <= 0)
+		{
+			b.m_knockdownTicks = 0;
+			b.m_state          = ACTIVE;
+		}
+
+		if (b.m_state == SWINGING)
+			++b.m_swingTicks;
+
+		b.m_stamina = std::max(0.0, std::min(maxStamina, b.m_stamina + m_game.getActiveHockeyistStaminaGrowthPerTick()));
+	}
+
+	if (m_restTicks > 0 && --m_restTicks == 0)
+		kickOff();
+}
+
+Simulator::Recorder::Recorder(const std::string& path, int teamSize, const Game& game)
+	: m_file(std::fopen(path.c_str(), "wb"))
+	, m_transport(new MemoryTransport())
+	, m_client(std::unique_ptr<Transport>(m_transport))
+	, m_sentFile(std::fopen((path + ".sent").c_str(), "wb"))
+	, m_sentTransport(new MemoryTransport())
+	, m_sentClient(std::unique_ptr<Transport>(m_sentTransport))
+{
+	m_client.writeTeamSizeMessage(teamSize);
+	m_client.writeGameContextMessage(game);
+	flush(m_file, *m_transport);
+
+	// what the runner sends before its first moves
+	m_sentClient.writeTokenMessage("0000000000000000");
+	m_sentClient.writeProtocolVersionMessage();
+	flush(m_sentFile, *m_sentTransport);
+}
+
+Simulator::Recorder::~Recorder()
+{
+	if (m_file)
+	{
+		m_client.writeGameOverMessage();
+		flush(m_file, *m_transport);
+		std::fclose(m_file);
+	}
+
+	if (m_sentFile)
+		std::fclose(m_sentFile);
+}
+
+void Simulator::Recorder::flush(FILE* file, MemoryTransport& transport)
+{
+	const std::vector<signed char>& bytes = transport.getOutput();
+	if (file && !bytes.empty())
+		std::fwrite(&bytes[0], 1, bytes.size(), file);
+	transport.clearOutput();
+}
+
+void Simulator::Recorder::write(const World& world)
+{
+	Hockeyists own;
+	for (const Hockeyist& h: world.getHockeyists())
+	{
+		if (h.isTeammate() && h.getType() != GOALIE)
+			own.push_back(h);
+	}
+
+	m_client.writePlayerContextMessage(PlayerContext(own, world));
+	flush(m_file, *m_transport);
+}
+
+void Simulator::Recorder::writeMoves(const World& world, const std::vector<Move>& moves)
+{
+	Moves own;
+	for (size_t i = 0; i < moves.size(); ++i)
+	{
+		const Hockeyist& h = world.getHockeyists()[i];
+		if (h.isTeammate() && h.getType() != GOALIE)
+			own.push_back(moves[i]);
+	}
+
+	m_sentClient.writeMovesMessage(own);
+	flush(m_sentFile, *m_sentTransport);
+}
+
+Simulator::Result Simulator::play(TTeam& left, TTeam& right)
+{
+	Result result = Result();
+
+	m_random.seed(m_options.m_seed);
+	m_goals[kLEFT] = m_goals[kRIGHT] = 0;
+	m_restTicks    = 0;
+	m_lastScorer   = -1;
+	m_isOvertime   = false;
+	createTeams();
+	kickOff();
+
+	TTeam* teams[2] = {&left, &right};
+	for (int team = kLEFT; team <= kRIGHT; ++team)
+		result.m_isCrashed[team] = static_cast<int>(teams[team]->size()) != m_options.m_teamSize;
+
+	const int regularTicks = m_options.m_tickCount > 0 ? m_options.m_tickCount : m_game.getTickCount();
+	const int lastTick     = regularTicks + (m_options.m_isOvertime ? m_game.getOvertimeTickCount() : 0);
+
+	std::unique_ptr<Recorder> recorder;
+	if (!m_options.m_recordPath.empty())
+		recorder.reset(new Recorder(m_options.m_recordPath, m_options.m_teamSize, m_game));
+
+	std::vector<Move> moves(m_bodies.size());
+	for (m_tick = 0; m_tick < lastTick; ++m_tick)
+	{
+		if (m_isOvertime && m_goals[kLEFT] != m_goals[kRIGHT])
+			break;
+
+		if (m_tick == regularTicks)
+		{
+			if (m_goals[kLEFT] != m_goals[kRIGHT])
+				break;
+
+			// sudden death without goalies
+			m_isOvertime = true;
+			m_bodies.erase(std::remove_if(m_bodies.begin(), m_bodies.end(), [](const Body& b) { return b.m_isGoalie; }), m_bodies.end());
+			moves.resize(m_bodies.size());
+			m_restTicks = 0;
+			kickOff();
+		}
+
+		// all decisions are made on the same state
+		std::fill(moves.begin(), moves.end(), Move());
+		for (int team = kLEFT; team <= kRIGHT; ++team)
+		{
+			if (result.m_isCrashed[team])
+				continue;
+
+			const World world = makeWorld(team);
+			if (recorder && team == kLEFT)
+				recorder->write(world);
+
+			for (size_t i = 0; i < m_bodies.size(); ++i)
+			{
+				if (m_bodies[i].m_team != team || m_bodies[i].m_isGoalie)
+					continue;
+
+				const Hockeyist& self = world.getHockeyists()[i];
+				try
+				{
+					(*teams[team])[self.getTeammateIndex()]->move(self, world, m_game, moves[i]);
+				}
+				catch (...)
+				{
+					result.m_isCrashed[team] = true;
+					moves[i] = Move();
+				}
+			}
+
+			if (recorder && team == kLEFT)
+				recorder->writeMoves(world, moves);
+		}
+
+		for (size_t i = 0; i < m_bodies.size(); ++i)
+		{
+			if (!m_bodies[i].m_isGoalie && !result.m_isCrashed[m_bodies[i].m_team])
+				applyMove(m_bodies[i], moves[i]);
+		}
+
+		moveGoalies();
+		moveBodies();
+		collide();
+		if (m_restTicks == 0)
+			movePuck();
+		updateTimers();
+	}
+
+	result.m_goals[kLEFT]  = m_goals[kLEFT];
+	result.m_goals[kRIGHT] = m_goals[kRIGHT];
+	result.m_ticks         = m_tick;
+	result.m_isOvertime    = m_isOvertime;
+	return result;
+}
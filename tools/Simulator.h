@@ -0,0 +1,138 @@
+#pragma once
+
+#ifndef _SIMULATOR_H_
+#define _SIMULATOR_H_
+
+#include "../Strategy.h"
+#include "../RemoteProcessClient.h"
+#include "../model/Game.h"
+#include "../model/World.h"
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+//! Headless approximation of CodeHockey rules: movement, walls and collisions, puck possession, swing/strike/pass,
+//! knockdowns, goalies, goals, after-goal rest and sudden-death overtime. Each field hockeyist is driven by its own
+//! Strategy instance and sees the world from its team's point of view, as with the real runner. No substitutions.
+class Simulator
+{
+public:
+	typedef std::vector<std::unique_ptr<Strategy>> TTeam;
+
+	static const int kLEFT  = 0;
+	static const int kRIGHT = 1;
+
+	struct Options
+	{
+		int      m_teamSize;     //!< field hockeyists per team
+		bool     m_hasGoalies;
+		unsigned m_seed;         //!< attributes, action chances and strike deviation
+		int      m_tickCount;    //!< 0 means game's tick count
+		bool     m_isOvertime;   //!< sudden death without goalies on draw
+		std::string m_recordPath; //!< kLEFT team's streams as runner --record writes them, empty for none
+
+		Options() : m_teamSize(2), m_hasGoalies(true), m_seed(0), m_tickCount(0), m_isOvertime(true) {}
+	};
+
+	struct Result
+	{
+		int  m_goals[2];         //!< by kLEFT and kRIGHT
+		int  m_ticks;
+		bool m_isOvertime;
+		bool m_isCrashed[2];     //!< strategy threw or team size mismatch
+	};
+
+private:
+	struct Body
+	{
+		long long              m_id;
+		int                    m_team;
+		int                    m_index;
+		bool                   m_isGoalie;
+		double                 m_x, m_y, m_speedX, m_speedY, m_angle, m_angularSpeed;
+		int                    m_strength, m_endurance, m_dexterity, m_agility;
+		double                 m_stamina;
+		model::HockeyistState  m_state;
+		int                    m_knockdownTicks;
+		int                    m_cooldownTicks;
+		int                    m_swingTicks;
+		model::ActionType      m_lastAction;
+		int                    m_lastActionTick;
+	};
+
+	struct PuckBody
+	{
+		double    m_x, m_y, m_speedX, m_speedY;
+		long long m_ownerId;     //!< -1 if free
+		int       m_ownerTeam;   //!< -1 if free
+	};
+
+	const model::Game& m_game;
+	Options            m_options;
+	std::mt19937       m_random;
+
+	std::vector<Body>  m_bodies;
+	PuckBody           m_puck;
+	int                m_tick;
+	int                m_goals[2];
+	int                m_restTicks;      //!< after-goal rest left, 0 in play
+	int                m_lastScorer;     //!< team which scored last goal, -1 if none
+	bool               m_isOvertime;
+
+	double getEffectiveness(const Body& b) const;
+	double getAgility(const Body& b) const        { return b.m_agility   / 100.0 * getEffectiveness(b); }
+	double getHandling(const Body& b) const;
+	double getStrength(const Body& b) const       { return b.m_strength  / 100.0 * getEffectiveness(b); }
+	double clampChance(double chance) const;
+	bool   isInStickReach(const Body& b, double x, double y) const;
+	bool   isChance(double chance)                { return std::uniform_real_distribution<double>(0, 1)(m_random) < chance; }
+	Body*  findBody(long long id);
+
+	void createTeams();
+	void kickOff();
+
+	model::World makeWorld(int team) const;
+	void         applyMove(Body& b, const model::Move& move);
+	void         takePuck(Body& b);
+	void         strike(Body& b);
+	void         pass(Body& b, const model::Move& move);
+	void         loosePuck(Body& owner, int cooldown);
+
+	void moveGoalies();
+	void moveBodies();
+	void movePuck();
+	void collide();
+	void updateTimers();
+	void scoreGoal(int team);
+
+	//! incoming stream of one team, encoded with the server side of the protocol, and its moves in path.sent
+	class Recorder
+	{
+		FILE*                m_file;
+		MemoryTransport*     m_transport;
+		RemoteProcessClient  m_client;
+		FILE*                m_sentFile;
+		MemoryTransport*     m_sentTransport;
+		RemoteProcessClient  m_sentClient;
+
+		static void flush(FILE* file, MemoryTransport& transport);
+
+	public:
+		Recorder(const std::string& path, int teamSize, const model::Game& game);
+		~Recorder();
+
+		void write(const model::World& world);
+		//! moves of the hockeyists last write() recorded, by body as the world lists them
+		void writeMoves(const model::World& world, const std::vector<model::Move>& moves);
+	};
+
+public:
+	Simulator(const model::Game& game, const Options& options);
+
+	//! plays whole match, left team defends left net
+	Result play(TTeam& left, TTeam& right);
+};
+
+#endif
@@ -0,0 +1,270 @@
+#include "Bench.h"
+#include "Recording.h"
+#include "WorldFactory.h"
+#include "../AllocationTracker.h"
+#include "../DecisionTrace.h"
+#include "../MyStrategy.h"
+#include "../PathPlanner.h"
+#include "../TeamContext.h"
+
+#include <cstdio>
+
+using namespace model;
+
+//! friend of MyStrategy, calls private hot paths on prepared worlds
+class StrategyBenchmark
+{
+	struct Sample
+	{
+		const World*     m_world;
+		const Hockeyist* m_self;        //!< my field hockeyist
+		const Hockeyist* m_opponent;    //!< opponent field hockeyist
+		int              m_teamSize;    //!< my field hockeyists
+		bool             m_hasGoalie;   //!< opponent goalie on the ice
+	};
+
+	Game                m_game;
+	std::vector<World>  m_corpus;
+	std::vector<Sample> m_samples;
+	TeamContext         m_team;
+	MyStrategy          m_strategy;
+	Move                m_move;
+
+	const Sample& prepare(unsigned i)
+	{
+		const Sample& s = m_samples[i % m_samples.size()];
+		m_move = Move();
+		m_team.m_scratch.reset();
+		m_strategy.update(s.m_self, s.m_world, &m_game, &m_move);
+		return s;
+	}
+
+	template <int TeamSize>
+	MyStrategy::TFirePositions fillFirePositions(const Sample& s)
+	{
+		return s.m_hasGoalie ? m_strategy.fillFirePositions<TeamSize, true>() : m_strategy.fillFirePositions<TeamSize, false>();
+	}
+
+	//! instantiation MyStrategy selects for the sample's game variant
+	MyStrategy::TFirePositions fillFirePositionsSpecialized(const Sample& s)
+	{
+		switch (s.m_teamSize)
+		{
+		case 2:  return fillFirePositions<2>(s);
+		case 3:  return fillFirePositions<3>(s);
+		case 6:  return fillFirePositions<6>(s);
+		default: return fillFirePositions<MyStrategy::kANY_TEAM_SIZE>(s);
+		}
+	}
+
+public:
+	StrategyBenchmark(const Game& game, const std::vector<World>& corpus)
+		: m_game(game)
+		, m_corpus(corpus)
+		, m_strategy(m_team)
+	{
+		for (const World& w: m_corpus)
+		{
+			Sample s = {&w, nullptr, nullptr, 0, false};
+			for (const Hockeyist& h: w.getHockeyists())
+			{
+				if (h.getType() == GOALIE)
+				{
+					s.m_hasGoalie = s.m_hasGoalie || !h.isTeammate();
+					continue;
+				}
+
+				if (h.isTeammate())
+					++s.m_teamSize;
+
+				if (h.isTeammate() && !s.m_self)
+					s.m_self = &h;
+				else if (!h.isTeammate() && !s.m_opponent)
+					s.m_opponent = &h;
+			}
+
+			if (s.m_self && s.m_opponent)
+				m_samples.push_back(s);
+		}
+
+		// let strategy initialize its statistics
+		Move move;
+		m_strategy.move(*m_samples.front().m_self, *m_samples.front().m_world, m_game, move);
+	}
+
+	//! MyStrategy::move over the corpus inside a no-alloc strategy scope, as the runner calls it, with the decision trace
+	//! on and wrapping around once; returns the allocations made there. One unchecked pass first creates per-hockeyist state.
+	unsigned long long checkNoAlloc(unsigned& moveCount)
+	{
+		m_team.m_decisionTrace.start();
+
+		Move move;
+		for (const Sample& s: m_samples)
+			m_strategy.move(*s.m_self, *s.m_world, m_game, move);
+
+		moveCount = DecisionTrace::kCAPACITY + static_cast<unsigned>(m_samples.size());
+		AllocationTracker::setPolicy(AllocationTracker::eCOUNT);
+		const unsigned long long allocationsBefore = AllocationTracker::getCount();
+		{
+			AllocationTracker::Scope scope(AllocationTracker::eSTRATEGY, true);
+			for (unsigned i = 0; i < moveCount; ++i)
+			{
+				const Sample& s = m_samples[i % m_samples.size()];
+				move = Move();
+				m_strategy.move(*s.m_self, *s.m_world, m_game, move);
+			}
+		}
+		return AllocationTracker::getCount() - allocationsBefore;
+	}
+
+	void run(const Bench::Options& options)
+	{
+		const unsigned ops = options.m_opsPerSample;
+
+		Bench::printHeader();
+
+		if (options.isSelected("Unit::getAngleTo"))
+			Bench::print(Bench::run("Unit::getAngleTo", options, ops, [this](unsigned i)
+			{
+				const Sample& s = m_samples[i % m_samples.size()];
+				Bench::doNotOptimize(s.m_self->getAngleTo(*s.m_opponent));
+			}));
+
+		if (options.isSelected("Unit::getDistanceTo"))
+			Bench::print(Bench::run("Unit::getDistanceTo", options, ops, [this](unsigned i)
+			{
+				const Sample& s = m_samples[i % m_samples.size()];
+				Bench::doNotOptimize(s.m_self->getDistanceTo(*s.m_opponent));
+			}));
+
+		if (options.isSelected("isInBetween"))
+			Bench::print(Bench::run("isInBetween", options, ops, [this](unsigned i)
+			{
+				const Sample& s    = m_samples[i % m_samples.size()];
+				const Puck&   puck = s.m_world->getPuck();
+				Bench::doNotOptimize(MyStrategy::isInBetween(Point(puck.getX(), puck.getY()), *s.m_opponent, *s.m_self, puck.getRadius()));
+			}));
+
+		if (options.isSelected("getEstimatedPuckPos"))
+			Bench::print(Bench::run("getEstimatedPuckPos", options, ops, [this](unsigned i)
+			{
+				prepare(i);
+				Bench::doNotOptimize(m_strategy.getEstimatedPuckPos());
+			}));
+
+		if (options.isSelected("getGhost"))
+			Bench::print(Bench::run("getGhost", options, ops, [this](unsigned i)
+			{
+				const Sample& s = prepare(i);
+				Bench::doNotOptimize(m_strategy.getGhost(*s.m_self, i % 30, s.m_self->getAngle(), 1.0));
+			}));
+
+		if (options.isSelected("fillFirePositions"))
+			Bench::print(Bench::run("fillFirePositions", options, ops / 10 + 1, [this](unsigned i)
+			{
+				const Sample& s = prepare(i);
+				Bench::doNotOptimize(fillFirePositions<MyStrategy::kANY_TEAM_SIZE>(s));
+			}));
+
+		if (options.isSelected("fillFirePositions<teamSize>"))
+			Bench::print(Bench::run("fillFirePositions<teamSize>", options, ops / 10 + 1, [this](unsigned i)
+			{
+				const Sample& s = prepare(i);
+				Bench::doNotOptimize(fillFirePositionsSpecialized(s));
+			}));
+
+		if (options.isSelected("fillDefenderPositions"))
+			Bench::print(Bench::run("fillDefenderPositions", options, ops / 10 + 1, [this](unsigned i)
+			{
+				const Sample& s = prepare(i);
+				Bench::doNotOptimize(m_strategy.fillDefenderPositions(s.m_opponent, s.m_self));
+			}));
+
+		if (options.isSelected("PathPlanner::findPath"))
+		{
+			PathPlanner planner;
+			Bench::print(Bench::run("PathPlanner::findPath", options, ops / 10 + 1, [this, &planner](unsigned i)
+			{
+				const Sample& s    = m_samples[i % m_samples.size()];
+				const Point   from = Point(s.m_self->getX(), s.m_self->getY());
+				const Point   to   = Point(m_game.getRinkRight() - from.x + m_game.getRinkLeft(), m_game.getRinkBottom() - from.y + m_game.getRinkTop());
+
+				planner.build(*s.m_world, m_game, s.m_self->getRadius());
+				Bench::doNotOptimize(planner.findPath(from, to));
+			}));
+		}
+
+		if (options.isSelected("MyStrategy::move"))
+			Bench::print(Bench::run("MyStrategy::move", options, ops / 10 + 1, [this](unsigned i)
+			{
+				const Sample& s = m_samples[i % m_samples.size()];
+				Move move;
+				m_strategy.move(*s.m_self, *s.m_world, m_game, move);
+				Bench::doNotOptimize(move);
+			}));
+	}
+};
+
+int main(int argc, char* argv[])
+{
+	Bench::Options options;
+	int            worldCount = 256;
+	unsigned       seed = 1;
+	std::string    corpusPath;
+	bool           isCheckNoAlloc = false;
+
+	bool isValid = true;
+	for (int next = 1; isValid && next < argc; ++next)
+	{
+		const std::string arg = argv[next];
+		if (Bench::parseOption(argc, argv, next, options))
+			continue;
+		else if (arg == "--worlds" && next + 1 < argc)
+			worldCount = std::atoi(argv[++next]);
+		else if (arg == "--seed" && next + 1 < argc)
+			seed = static_cast<unsigned>(std::atoi(argv[++next]));
+		else if (arg == "--corpus" && next + 1 < argc)
+			corpusPath = argv[++next];
+		else if (arg == "--check-no-alloc")
+			isCheckNoAlloc = true;
+		else
+			isValid = false;
+	}
+
+	if (!isValid || worldCount <= 0)
+	{
+		std::fprintf(stderr, "usage: %s [--samples N] [--ops N] [--filter name] [--worlds N] [--seed N] [--corpus recorded.bin] [--check-no-alloc]\n", argv[0]);
+		return 1;
+	}
+
+	// synthetic worlds, followed by recorded ones if given
+	const Game         game   = WorldFactory::makeGame();
+	std::vector<World> corpus = WorldFactory::makeCorpus(game, worldCount, seed);
+
+	Recording recording;
+	if (!corpusPath.empty())
+	{
+		if (!recording.load(corpusPath))
+		{
+			std::fprintf(stderr, "can't load recording %s\n", corpusPath.c_str());
+			return 2;
+		}
+
+		for (const PlayerContext& context: recording.m_contexts)
+			corpus.push_back(context.getWorld());
+	}
+
+	StrategyBenchmark benchmark(recording.m_contexts.empty() ? game : recording.m_game, corpus);
+
+	// instead of benchmarks: fails when the strategy allocates in its no-alloc scope
+	if (isCheckNoAlloc)
+	{
+		unsigned                 moveCount   = 0;
+		const unsigned long long allocations = benchmark.checkNoAlloc(moveCount);
+		std::printf("MyStrategy::move: %llu allocations in %u moves in no-alloc scope\n", allocations, moveCount);
+		return allocations == 0 ? 0 : 3;
+	}
+
+	benchmark.run(options);
+	return 0;
+}
@@ -0,0 +1,32 @@
+#include "StrategyPlugin.h"
+#include "../MyStrategy.h"
+#include "../TeamContext.h"
+
+#if defined(_MSC_VER)
+#	define STRATEGY_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#	define STRATEGY_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+extern "C"
+{
+	STRATEGY_PLUGIN_EXPORT int getStrategyPluginVersion()
+	{
+		return kSTRATEGY_PLUGIN_VERSION;
+	}
+
+	STRATEGY_PLUGIN_EXPORT void* createStrategyTeam()
+	{
+		return new TeamContext();
+	}
+
+	STRATEGY_PLUGIN_EXPORT Strategy* createStrategy(void* team)
+	{
+		return new MyStrategy(*static_cast<TeamContext*>(team));
+	}
+
+	STRATEGY_PLUGIN_EXPORT void destroyStrategyTeam(void* team)
+	{
+		delete static_cast<TeamContext*>(team);
+	}
+}
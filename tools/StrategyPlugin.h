@@ -0,0 +1,20 @@
+#pragma once
+
+#ifndef _STRATEGY_PLUGIN_H_
+#define _STRATEGY_PLUGIN_H_
+
+#include "../Strategy.h"
+
+//! C interface of strategy built as loadable module, so a baseline build can play against the current one.
+//! Both sides must agree on model classes and Strategy layout, bump kSTRATEGY_PLUGIN_VERSION when they change.
+static const int kSTRATEGY_PLUGIN_VERSION = 1;
+
+extern "C"
+{
+	typedef int       (*TGetStrategyPluginVersion)();
+	typedef void*     (*TCreateStrategyTeam)();
+	typedef Strategy* (*TCreateStrategy)(void* team);
+	typedef void      (*TDestroyStrategyTeam)(void* team);
+}
+
+#endif
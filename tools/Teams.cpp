@@ -0,0 +1,135 @@
+#include "Teams.h"
+#include "BaselineStrategy.h"
+#include "StrategyPlugin.h"
+#include "../MyStrategy.h"
+#include "../TeamContext.h"
+
+#ifdef _LINUX
+#	include <dlfcn.h>
+#endif
+
+namespace
+{
+	class MyTeamFactory : public TeamFactory
+	{
+		const std::string m_name;
+		const Parameters  m_parameters;
+
+	public:
+		MyTeamFactory(const Parameters& parameters, const std::string& name) : m_name(name), m_parameters(parameters) {}
+
+		const std::string& getName() const { return m_name; }
+
+		Team create(int teamSize) const
+		{
+			std::shared_ptr<TeamContext> context = std::make_shared<TeamContext>();
+			context->m_parameters = m_parameters;
+
+			Team team;
+			team.m_context = context;
+			for (int i = 0; i < teamSize; ++i)
+				team.m_strategies.push_back(std::unique_ptr<Strategy>(new MyStrategy(*context, teamSize)));
+			return team;
+		}
+	};
+
+	class BaselineTeamFactory : public TeamFactory
+	{
+		const std::string m_name;
+
+	public:
+		BaselineTeamFactory() : m_name("baseline") {}
+
+		const std::string& getName() const { return m_name; }
+
+		Team create(int teamSize) const
+		{
+			Team team;
+			for (int i = 0; i < teamSize; ++i)
+				team.m_strategies.push_back(std::unique_ptr<Strategy>(new BaselineStrategy()));
+			return team;
+		}
+	};
+
+#ifdef _LINUX
+	//! module is never unloaded, teams may outlive the factory
+	class PluginTeamFactory : public TeamFactory
+	{
+		const std::string    m_name;
+		TCreateStrategyTeam  m_createTeam;
+		TCreateStrategy      m_createStrategy;
+		TDestroyStrategyTeam m_destroyTeam;
+
+	public:
+		PluginTeamFactory(const std::string& path, TCreateStrategyTeam createTeam, TCreateStrategy createStrategy, TDestroyStrategyTeam destroyTeam)
+			: m_name(path), m_createTeam(createTeam), m_createStrategy(createStrategy), m_destroyTeam(destroyTeam)
+		{}
+
+		const std::string& getName() const { return m_name; }
+
+		Team create(int teamSize) const
+		{
+			Team team;
+			team.m_context = std::shared_ptr<void>(m_createTeam(), m_destroyTeam);
+			for (int i = 0; i < teamSize; ++i)
+				team.m_strategies.push_back(std::unique_ptr<Strategy>(m_createStrategy(team.m_context.get())));
+			return team;
+		}
+	};
+#endif
+}
+
+TeamFactory::~TeamFactory()
+{
+}
+
+std::unique_ptr<TeamFactory> TeamFactory::make(const Parameters& parameters, const std::string& name)
+{
+	return std::unique_ptr<TeamFactory>(new MyTeamFactory(parameters, name));
+}
+
+std::unique_ptr<TeamFactory> TeamFactory::make(const std::string& spec, std::string& error)
+{
+	if (spec == "mine")
+		return make(Parameters(), spec);
+	if (spec.compare(0, 5, "mine:") == 0)
+	{
+		Parameters parameters;
+		if (!parameters.load(spec.substr(5), error))
+			return nullptr;
+		return make(parameters, spec);
+	}
+	if (spec == "baseline")
+		return std::unique_ptr<TeamFactory>(new BaselineTeamFactory());
+
+#ifdef _LINUX
+	// own copy of strategy statics and symbols, see RTLD_LOCAL and -Bsymbolic of the module
+	void* module = ::dlopen(spec.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if (!module)
+	{
+		error = ::dlerror();
+		return nullptr;
+	}
+
+	TGetStrategyPluginVersion getVersion     = reinterpret_cast<TGetStrategyPluginVersion>(::dlsym(module, "getStrategyPluginVersion"));
+	TCreateStrategyTeam       createTeam     = reinterpret_cast<TCreateStrategyTeam>(::dlsym(module, "createStrategyTeam"));
+	TCreateStrategy           createStrategy = reinterpret_cast<TCreateStrategy>(::dlsym(module, "createStrategy"));
+	TDestroyStrategyTeam      destroyTeam    = reinterpret_cast<TDestroyStrategyTeam>(::dlsym(module, "destroyStrategyTeam"));
+	if (!getVersion || !createTeam || !createStrategy || !destroyTeam)
+	{
+		error = spec + " is not a strategy plugin";
+		return nullptr;
+	}
+
+	if (getVersion() != kSTRATEGY_PLUGIN_VERSION)
+	{
+		error = spec + " has plugin version " + std::to_string(getVersion()) + ", expected " + std::to_string(kSTRATEGY_PLUGIN_VERSION);
+		return nullptr;
+	}
+
+	return std::unique_ptr<TeamFactory>(new PluginTeamFactory(spec, createTeam, createStrategy, destroyTeam));
+#else
+	error = "strategy plugins are supported on Linux only";
+	return nullptr;
+#endif
+}
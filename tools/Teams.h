@@ -0,0 +1,35 @@
+#pragma once
+
+#ifndef _TEAMS_H_
+#define _TEAMS_H_
+
+#include "Simulator.h"
+#include "../Parameters.h"
+#include <memory>
+#include <string>
+
+//! Strategies of one team in one match and the state they share. Strategies are released first.
+struct Team
+{
+	std::shared_ptr<void> m_context;
+	Simulator::TTeam      m_strategies;
+};
+
+//! Makes fresh teams for each match, must be callable from several threads at once
+class TeamFactory
+{
+public:
+	virtual ~TeamFactory();
+
+	virtual const std::string& getName() const = 0;
+	virtual Team create(int teamSize) const = 0;
+
+	//! "mine" for linked MyStrategy, "mine:file" for it with parameters from file, "baseline" for BaselineStrategy,
+	//! otherwise path to strategy plugin; nullptr on error
+	static std::unique_ptr<TeamFactory> make(const std::string& spec, std::string& error);
+
+	//! linked MyStrategy with given parameters
+	static std::unique_ptr<TeamFactory> make(const Parameters& parameters, const std::string& name);
+};
+
+#endif
@@ -0,0 +1,133 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct Estimate
+	{
+		double m_mean;
+		double m_margin;    //!< half-width of 95% confidence interval
+	};
+
+	template <typename F>
+	Estimate estimate(const std::vector<MatchResult>& results, const F& value)
+	{
+		const double n = static_cast<double>(results.size());
+		double sum = 0, sum2 = 0;
+		for (const MatchResult& r: results)
+		{
+			const double v = value(r);
+			sum  += v;
+			sum2 += v * v;
+		}
+
+		const double mean     = sum / n;
+		const double variance = n > 1 ? std::max(0.0, (sum2 - n * mean * mean) / (n - 1)) : 0;
+		Estimate e = {mean, 1.96 * std::sqrt(variance / n)};
+		return e;
+	}
+
+	double toElo(double score)
+	{
+		score = std::max(0.001, std::min(0.999, score));
+		return 400.0 * std::log10(score / (1.0 - score));
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Simulator::Options options;
+	int                matchCount    = 1000;
+	int                threadCount   = static_cast<int>(std::thread::hardware_concurrency());
+	std::string        candidateSpec = "mine";
+	std::string        baselineSpec  = "baseline";
+	bool               isVerbose     = false;
+
+	bool isValid = true;
+	for (int next = 1; isValid && next < argc; ++next)
+	{
+		const std::string arg = argv[next];
+		if (arg == "--matches" && next + 1 < argc)
+			matchCount = std::atoi(argv[++next]);
+		else if (arg == "--threads" && next + 1 < argc)
+			threadCount = std::atoi(argv[++next]);
+		else if (arg == "--seed" && next + 1 < argc)
+			options.m_seed = static_cast<unsigned>(std::atoi(argv[++next]));
+		else if (arg == "--team-size" && next + 1 < argc)
+			options.m_teamSize = std::atoi(argv[++next]);
+		else if (arg == "--ticks" && next + 1 < argc)
+			options.m_tickCount = std::atoi(argv[++next]);
+		else if (arg == "--candidate" && next + 1 < argc)
+			candidateSpec = argv[++next];
+		else if (arg == "--baseline" && next + 1 < argc)
+			baselineSpec = argv[++next];
+		else if (arg == "--no-goalies")
+			options.m_hasGoalies = false;
+		else if (arg == "--no-overtime")
+			options.m_isOvertime = false;
+		else if (arg == "--record" && next + 1 < argc)
+			options.m_recordPath = argv[++next];
+		else if (arg == "--verbose")
+			isVerbose = true;
+		else
+			isValid = false;
+	}
+
+	if (!isValid || matchCount <= 0 || options.m_teamSize <= 0)
+	{
+		std::fprintf(stderr, "usage: %s [--matches N] [--threads N] [--seed N] [--team-size N] [--ticks N] [--no-goalies] [--no-overtime]\n"
+			"    [--candidate mine[:params]|baseline|plugin.so] [--baseline mine[:params]|baseline|plugin.so] [--record dir] [--verbose]\n", argv[0]);
+		return 1;
+	}
+
+	std::string error;
+	const std::unique_ptr<TeamFactory> candidate = TeamFactory::make(candidateSpec, error);
+	const std::unique_ptr<TeamFactory> baseline  = candidate ? TeamFactory::make(baselineSpec, error) : nullptr;
+	if (!candidate || !baseline)
+	{
+		std::fprintf(stderr, "%s\n", error.c_str());
+		return 2;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	const std::vector<MatchResult> results = playMatches(*candidate, *baseline, options, matchCount, std::max(threadCount, 1));
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	int wins = 0, draws = 0, losses = 0, goalsFor = 0, goalsAgainst = 0, overtimes = 0, candidateCrashes = 0, baselineCrashes = 0;
+	for (const MatchResult& r: results)
+	{
+		if (isVerbose)
+			std::printf("seed %6u %s: %d:%d%s%s%s\n", r.m_seed, r.m_isCandidateLeft ? "left " : "right", r.m_candidateGoals, r.m_baselineGoals,
+				r.m_isOvertime ? " (overtime)" : "", r.m_isCandidateCrashed ? " CANDIDATE CRASHED" : "", r.m_isBaselineCrashed ? " BASELINE CRASHED" : "");
+
+		wins             += r.m_candidateGoals > r.m_baselineGoals ? 1 : 0;
+		draws            += r.m_candidateGoals == r.m_baselineGoals ? 1 : 0;
+		losses           += r.m_candidateGoals < r.m_baselineGoals ? 1 : 0;
+		goalsFor         += r.m_candidateGoals;
+		goalsAgainst     += r.m_baselineGoals;
+		overtimes        += r.m_isOvertime ? 1 : 0;
+		candidateCrashes += r.m_isCandidateCrashed ? 1 : 0;
+		baselineCrashes  += r.m_isBaselineCrashed ? 1 : 0;
+	}
+
+	const Estimate score = estimate(results, [](const MatchResult& r) { return r.getScore(); });
+	const Estimate diff  = estimate(results, [](const MatchResult& r) { return static_cast<double>(r.m_candidateGoals - r.m_baselineGoals); });
+
+	std::printf("%s vs %s, %d matches, team size %d%s\n", candidate->getName().c_str(), baseline->getName().c_str(), matchCount,
+		options.m_teamSize, options.m_hasGoalies ? "" : ", no goalies");
+	std::printf("wins %d, draws %d, losses %d, overtimes %d, crashes %d:%d\n", wins, draws, losses, overtimes, candidateCrashes, baselineCrashes);
+	std::printf("score      %.3f +- %.3f (draw = 0.5), elo %+.0f [%+.0f, %+.0f]\n", score.m_mean, score.m_margin,
+		toElo(score.m_mean), toElo(score.m_mean - score.m_margin), toElo(score.m_mean + score.m_margin));
+	std::printf("goals      %d:%d, diff per match %+.3f +- %.3f\n", goalsFor, goalsAgainst, diff.m_mean, diff.m_margin);
+	std::printf("%.1f s, %.1f ms per match on %d threads\n", seconds, seconds * 1000 / matchCount, std::max(threadCount, 1));
+	return 0;
+}
@@ -0,0 +1,261 @@
+#include "../DecisionTrace.h"
+#include "../Plan.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+	const char* getReplanName(int reason)
+	{
+		switch (reason)
+		{
+		case Plan::eVALID:             return "kept";
+		case Plan::eEMPTY:             return "empty";
+		case Plan::eSITUATION_CHANGED: return "situation changed";
+		case Plan::eEXPIRED:           return "expired";
+		case Plan::eCORRIDOR_BLOCKED:  return "corridor blocked";
+		}
+		return "unknown";
+	}
+
+	double getPercentile(std::vector<double> values, double fraction)
+	{
+		if (values.empty())
+			return 0;
+
+		const size_t n = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+		std::nth_element(values.begin(), values.begin() + n, values.end());
+		return values[n];
+	}
+
+	void printRow(const DecisionTrace::Row& r)
+	{
+		std::printf("%6d %6lld %-15s %-18s %3d %4u %8.1f %8.1f %8.1f %8.1f %8.2f %6lld %s\n", r.m_tick, r.m_hockeyistId,
+			DecisionTrace::getBehaviourName(r.m_behaviour), getReplanName(r.m_replanReason), r.m_action, r.m_candidates,
+			r.m_fireX, r.m_fireY, r.m_interceptX, r.m_interceptY, r.m_moveNs / 1000.0, r.m_puckOwnerId,
+			r.m_isScored ? "scored" : r.m_isConceded ? "conceded" : "");
+	}
+
+	void printRowHeader()
+	{
+		std::printf("%6s %6s %-15s %-18s %3s %4s %8s %8s %8s %8s %8s %6s %s\n",
+			"tick", "id", "behaviour", "replan", "act", "cand", "fire_x", "fire_y", "icpt_x", "icpt_y", "move_us", "owner", "goal");
+	}
+
+	void printSummary(const std::vector<DecisionTrace::Row>& rows)
+	{
+		int firstTick = rows.empty() ? 0 : rows.front().m_tick;
+		int lastTick  = firstTick;
+		for (const DecisionTrace::Row& r: rows)
+		{
+			firstTick = std::min(firstTick, r.m_tick);
+			lastTick  = std::max(lastTick, r.m_tick);
+		}
+		std::printf("rows: %u, ticks %d..%d\n\n", static_cast<unsigned>(rows.size()), firstTick, lastTick);
+
+		std::printf("%-15s %7s %7s %10s %10s %10s %10s %9s\n", "behaviour", "rows", "share", "mean_us", "p50_us", "p99_us", "max_us", "avg_cand");
+		for (int b = 0; b < DecisionTrace::eBEHAVIOUR_COUNT; ++b)
+		{
+			std::vector<double> times;
+			double candidates = 0;
+			for (const DecisionTrace::Row& r: rows)
+			{
+				if (r.m_behaviour != b)
+					continue;
+				times.push_back(r.m_moveNs / 1000.0);
+				candidates += r.m_candidates;
+			}
+
+			if (times.empty())
+				continue;
+
+			double total = 0;
+			for (double t: times)
+				total += t;
+
+			std::printf("%-15s %7u %6.1f%% %10.2f %10.2f %10.2f %10.2f %9.2f\n", DecisionTrace::getBehaviourName(b),
+				static_cast<unsigned>(times.size()), 100.0 * times.size() / rows.size(), total / times.size(),
+				getPercentile(times, 0.5), getPercentile(times, 0.99), *std::max_element(times.begin(), times.end()), candidates / times.size());
+		}
+
+		std::printf("\n%-18s %7s\n", "replan", "rows");
+		for (int reason = Plan::eVALID; reason <= Plan::eCORRIDOR_BLOCKED; ++reason)
+		{
+			const long count = std::count_if(rows.begin(), rows.end(), [reason](const DecisionTrace::Row& r) { return r.m_replanReason == reason; });
+			if (count)
+				std::printf("%-18s %7ld\n", getReplanName(reason), count);
+		}
+	}
+
+	//! first tick of each goal: flag set and not set on the previous traced tick
+	std::vector<int> findGoalTicks(const std::vector<DecisionTrace::Row>& rows, unsigned char DecisionTrace::Row::* flag)
+	{
+		std::set<int> ticks;
+		std::set<int> flagged;
+		for (const DecisionTrace::Row& r: rows)
+		{
+			ticks.insert(r.m_tick);
+			if (r.*flag)
+				flagged.insert(r.m_tick);
+		}
+
+		std::vector<int> goals;
+		bool wasFlagged = false;
+		for (int tick: ticks)
+		{
+			const bool isFlagged = flagged.count(tick) != 0;
+			if (isFlagged && !wasFlagged)
+				goals.push_back(tick);
+			wasFlagged = isFlagged;
+		}
+		return goals;
+	}
+
+	//! behaviour, replan reason and puck possession in the window before each conceded goal, next to the whole game
+	void printConcededReport(const std::vector<DecisionTrace::Row>& rows, const std::set<long long>& myIds, int window)
+	{
+		const std::vector<int> conceded = findGoalTicks(rows, &DecisionTrace::Row::m_isConceded);
+		const std::vector<int> scored   = findGoalTicks(rows, &DecisionTrace::Row::m_isScored);
+		std::printf("\ngoals: scored %u, conceded %u\n", static_cast<unsigned>(scored.size()), static_cast<unsigned>(conceded.size()));
+		if (conceded.empty())
+			return;
+
+		std::vector<const DecisionTrace::Row*> before;
+		for (const DecisionTrace::Row& r: rows)
+		{
+			for (int goal: conceded)
+			{
+				if (r.m_tick >= goal - window && r.m_tick < goal)
+				{
+					before.push_back(&r);
+					break;
+				}
+			}
+		}
+
+		std::printf("\n%d ticks before goals conceded at", window);
+		for (int goal: conceded)
+			std::printf(" %d", goal);
+		std::printf("\n");
+		if (before.empty())
+			return;
+
+		const double windowRows = static_cast<double>(before.size());
+		const double gameRows   = static_cast<double>(rows.size());
+
+		std::printf("%-18s %7s %9s %9s\n", "behaviour", "rows", "share", "game");
+		for (int b = 0; b < DecisionTrace::eBEHAVIOUR_COUNT; ++b)
+		{
+			const long inWindow = std::count_if(before.begin(), before.end(), [b](const DecisionTrace::Row* r) { return r->m_behaviour == b; });
+			const long inGame   = std::count_if(rows.begin(), rows.end(), [b](const DecisionTrace::Row& r) { return r.m_behaviour == b; });
+			if (inWindow)
+				std::printf("%-18s %7ld %8.1f%% %8.1f%%\n", DecisionTrace::getBehaviourName(b), inWindow, 100.0 * inWindow / windowRows, 100.0 * inGame / gameRows);
+		}
+
+		std::printf("%-18s %7s %9s %9s\n", "replan", "rows", "share", "game");
+		for (int reason = Plan::eVALID; reason <= Plan::eCORRIDOR_BLOCKED; ++reason)
+		{
+			const long inWindow = std::count_if(before.begin(), before.end(), [reason](const DecisionTrace::Row* r) { return r->m_replanReason == reason; });
+			const long inGame   = std::count_if(rows.begin(), rows.end(), [reason](const DecisionTrace::Row& r) { return r.m_replanReason == reason; });
+			if (inWindow)
+				std::printf("%-18s %7ld %8.1f%% %8.1f%%\n", getReplanName(reason), inWindow, 100.0 * inWindow / windowRows, 100.0 * inGame / gameRows);
+		}
+
+		// rows name our own hockeyists only, so any other owner is an opponent
+		const char* const kOWNERS[] = {"free", "mine", "opponent"};
+		auto getOwner = [&myIds](const DecisionTrace::Row& r) { return r.m_puckOwnerId == -1 ? 0 : myIds.count(r.m_puckOwnerId) ? 1 : 2; };
+		std::printf("%-18s %7s %9s %9s\n", "puck", "rows", "share", "game");
+		for (int owner = 0; owner < 3; ++owner)
+		{
+			const long inWindow = std::count_if(before.begin(), before.end(), [&](const DecisionTrace::Row* r) { return getOwner(*r) == owner; });
+			const long inGame   = std::count_if(rows.begin(), rows.end(), [&](const DecisionTrace::Row& r) { return getOwner(r) == owner; });
+			if (inWindow)
+				std::printf("%-18s %7ld %8.1f%% %8.1f%%\n", kOWNERS[owner], inWindow, 100.0 * inWindow / windowRows, 100.0 * inGame / gameRows);
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::string path;
+	bool        isDump      = false;
+	long long   hockeyistId = -1;
+	int         fromTick    = 0;
+	int         toTick      = 1 << 30;
+	int         top         = 10;
+	int         window      = 60;
+
+	bool isValid = true;
+	for (int next = 1; isValid && next < argc; ++next)
+	{
+		const std::string arg = argv[next];
+		if (arg == "--dump")
+			isDump = true;
+		else if (arg == "--hockeyist" && next + 1 < argc)
+			hockeyistId = std::atoll(argv[++next]);
+		else if (arg == "--from" && next + 1 < argc)
+			fromTick = std::atoi(argv[++next]);
+		else if (arg == "--to" && next + 1 < argc)
+			toTick = std::atoi(argv[++next]);
+		else if (arg == "--top" && next + 1 < argc)
+			top = std::atoi(argv[++next]);
+		else if (arg == "--window" && next + 1 < argc)
+			window = std::atoi(argv[++next]);
+		else if (path.empty() && arg[0] != '-')
+			path = arg;
+		else
+			isValid = false;
+	}
+
+	if (!isValid || path.empty())
+	{
+		std::fprintf(stderr, "usage: %s trace.bin [--dump] [--hockeyist id] [--from tick] [--to tick] [--top N] [--window ticks]\n", argv[0]);
+		return 1;
+	}
+
+	std::vector<DecisionTrace::Row> rows;
+	if (!DecisionTrace::read(path, rows))
+	{
+		std::fprintf(stderr, "can't read trace %s\n", path.c_str());
+		return 2;
+	}
+
+	// before filtering, so a puck owned by any teammate counts as mine
+	std::set<long long> myIds;
+	for (const DecisionTrace::Row& r: rows)
+		myIds.insert(r.m_hockeyistId);
+
+	rows.erase(std::remove_if(rows.begin(), rows.end(), [=](const DecisionTrace::Row& r)
+	{
+		return (hockeyistId != -1 && r.m_hockeyistId != hockeyistId) || r.m_tick < fromTick || r.m_tick > toTick;
+	}), rows.end());
+
+	if (isDump)
+	{
+		printRowHeader();
+		for (const DecisionTrace::Row& r: rows)
+			printRow(r);
+		return 0;
+	}
+
+	printSummary(rows);
+	printConcededReport(rows, myIds, window);
+
+	// slowest decisions, the ones to look at first
+	std::vector<DecisionTrace::Row> slowest = rows;
+	std::sort(slowest.begin(), slowest.end(), [](const DecisionTrace::Row& a, const DecisionTrace::Row& b) { return a.m_moveNs > b.m_moveNs; });
+	slowest.resize(std::min<size_t>(slowest.size(), std::max(top, 0)));
+
+	std::printf("\nslowest %u:\n", static_cast<unsigned>(slowest.size()));
+	printRowHeader();
+	for (const DecisionTrace::Row& r: slowest)
+		printRow(r);
+
+	return 0;
+}
@@ -0,0 +1,228 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// SPSA over strategy parameters: each iteration perturbs all tuned parameters at once by random +-c, plays the
+// plus vector against the minus one (or both against an opponent) and steps along the estimated gradient.
+// Works in [0, 1] coordinates of each parameter's range, so one step size fits all of them.
+namespace
+{
+	typedef std::vector<double> TPoint;
+
+	struct Settings
+	{
+		int                       m_iterations;
+		int                       m_matches;       //!< per iteration, even
+		int                       m_threads;
+		double                    m_a;             //!< step size at first iteration
+		double                    m_c;             //!< perturbation at first iteration
+		std::string               m_opponentSpec;  //!< empty for plus against minus
+		std::string               m_outPath;
+		std::vector<Parameters::Id> m_ids;         //!< tuned parameters
+	};
+
+	double toUnit(Parameters::Id id, double value)
+	{
+		const Parameters::Info& info = Parameters::getInfo(id);
+		return (value - info.m_min) / (info.m_max - info.m_min);
+	}
+
+	double fromUnit(Parameters::Id id, double unit)
+	{
+		const Parameters::Info& info = Parameters::getInfo(id);
+		return info.m_min + std::max(0.0, std::min(1.0, unit)) * (info.m_max - info.m_min);
+	}
+
+	Parameters makeParameters(const Parameters& base, const Settings& settings, const TPoint& point)
+	{
+		Parameters parameters = base;
+		for (size_t i = 0; i < settings.m_ids.size(); ++i)
+			parameters.set(settings.m_ids[i], fromUnit(settings.m_ids[i], point[i]));
+		return parameters;
+	}
+
+	double getScore(const std::vector<MatchResult>& results)
+	{
+		double score = 0;
+		for (const MatchResult& r: results)
+			score += r.getScore();
+		return results.empty() ? 0.5 : score / results.size();
+	}
+
+	bool parseIds(const std::string& list, std::vector<Parameters::Id>& ids)
+	{
+		size_t begin = 0;
+		while (begin <= list.size())
+		{
+			const size_t end  = std::min(list.find(',', begin), list.size());
+			const std::string name = list.substr(begin, end - begin);
+
+			int id = 0;
+			while (id < Parameters::ePARAMETER_COUNT && name != Parameters::getInfo(static_cast<Parameters::Id>(id)).m_name)
+				++id;
+			if (id == Parameters::ePARAMETER_COUNT)
+				return false;
+
+			ids.push_back(static_cast<Parameters::Id>(id));
+			begin = end + 1;
+		}
+		return true;
+	}
+
+	void printParameters(const Parameters& parameters, const Settings& settings)
+	{
+		for (Parameters::Id id: settings.m_ids)
+			std::printf(" %s=%.4g", Parameters::getInfo(id).m_name, parameters[id]);
+		std::printf("\n");
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Simulator::Options options;
+	Settings           settings;
+	std::string        startPath;
+	std::string        onlyList;
+
+	settings.m_iterations = 100;
+	settings.m_matches    = 64;
+	settings.m_threads    = static_cast<int>(std::thread::hardware_concurrency());
+	settings.m_a          = 0.02;
+	settings.m_c          = 0.1;
+	settings.m_outPath    = "tuned.params";
+
+	bool isValid = true;
+	for (int next = 1; isValid && next < argc; ++next)
+	{
+		const std::string arg = argv[next];
+		if (arg == "--iterations" && next + 1 < argc)
+			settings.m_iterations = std::atoi(argv[++next]);
+		else if (arg == "--matches" && next + 1 < argc)
+			settings.m_matches = std::atoi(argv[++next]);
+		else if (arg == "--threads" && next + 1 < argc)
+			settings.m_threads = std::atoi(argv[++next]);
+		else if (arg == "--a" && next + 1 < argc)
+			settings.m_a = std::atof(argv[++next]);
+		else if (arg == "--c" && next + 1 < argc)
+			settings.m_c = std::atof(argv[++next]);
+		else if (arg == "--opponent" && next + 1 < argc)
+			settings.m_opponentSpec = argv[++next];
+		else if (arg == "--out" && next + 1 < argc)
+			settings.m_outPath = argv[++next];
+		else if (arg == "--start" && next + 1 < argc)
+			startPath = argv[++next];
+		else if (arg == "--only" && next + 1 < argc)
+			onlyList = argv[++next];
+		else if (arg == "--seed" && next + 1 < argc)
+			options.m_seed = static_cast<unsigned>(std::atoi(argv[++next]));
+		else if (arg == "--team-size" && next + 1 < argc)
+			options.m_teamSize = std::atoi(argv[++next]);
+		else if (arg == "--ticks" && next + 1 < argc)
+			options.m_tickCount = std::atoi(argv[++next]);
+		else if (arg == "--no-goalies")
+			options.m_hasGoalies = false;
+		else
+			isValid = false;
+	}
+
+	if (!isValid || settings.m_iterations <= 0 || settings.m_matches < 2 || settings.m_c <= 0 || (!onlyList.empty() && !parseIds(onlyList, settings.m_ids)))
+	{
+		std::fprintf(stderr, "usage: %s [--iterations N] [--matches N] [--threads N] [--a step] [--c perturbation] [--opponent spec]\n"
+			"    [--start params] [--only name,name (default all tunable)] [--out params] [--seed N] [--team-size N] [--ticks N] [--no-goalies]\n", argv[0]);
+		return 1;
+	}
+
+	if (settings.m_ids.empty())
+	{
+		for (int id = 0; id < Parameters::ePARAMETER_COUNT; ++id)
+		{
+			if (Parameters::getInfo(static_cast<Parameters::Id>(id)).m_isTunable)
+				settings.m_ids.push_back(static_cast<Parameters::Id>(id));
+		}
+	}
+
+	std::string error;
+	Parameters  base;
+	if (!startPath.empty() && !base.load(startPath, error))
+	{
+		std::fprintf(stderr, "%s\n", error.c_str());
+		return 2;
+	}
+
+	std::unique_ptr<TeamFactory> opponent;
+	if (!settings.m_opponentSpec.empty() && !(opponent = TeamFactory::make(settings.m_opponentSpec, error)))
+	{
+		std::fprintf(stderr, "%s\n", error.c_str());
+		return 2;
+	}
+
+	TPoint point;
+	for (Parameters::Id id: settings.m_ids)
+		point.push_back(toUnit(id, base[id]));
+
+	std::printf("start:");
+	printParameters(base, settings);
+
+	// standard SPSA gain sequences, stability constant at 10% of iterations
+	const double       kALPHA     = 0.602;
+	const double       kGAMMA     = 0.101;
+	const double       kSTABILITY = settings.m_iterations / 10.0;
+	std::mt19937       random(options.m_seed);
+	Simulator::Options iterationOptions = options;
+
+	for (int k = 0; k < settings.m_iterations; ++k)
+	{
+		const double ak = settings.m_a / std::pow(k + 1 + kSTABILITY, kALPHA);
+		const double ck = settings.m_c / std::pow(k + 1, kGAMMA);
+
+		TPoint delta(point.size()), plus(point.size()), minus(point.size());
+		for (size_t i = 0; i < point.size(); ++i)
+		{
+			delta[i] = (random() & 1) ? 1.0 : -1.0;
+			plus[i]  = point[i] + ck * delta[i];
+			minus[i] = point[i] - ck * delta[i];
+		}
+
+		// fresh seeds each iteration, so the tuner doesn't fit a fixed set of games
+		iterationOptions.m_seed = options.m_seed + static_cast<unsigned>(k * settings.m_matches);
+
+		const std::unique_ptr<TeamFactory> plusTeam  = TeamFactory::make(makeParameters(base, settings, plus),  "plus");
+		const std::unique_ptr<TeamFactory> minusTeam = TeamFactory::make(makeParameters(base, settings, minus), "minus");
+
+		double difference = 0;   // score of plus minus score of minus
+		if (opponent)
+		{
+			difference = getScore(playMatches(*plusTeam,  *opponent, iterationOptions, settings.m_matches, settings.m_threads))
+			           - getScore(playMatches(*minusTeam, *opponent, iterationOptions, settings.m_matches, settings.m_threads));
+		}
+		else
+		{
+			difference = 2 * getScore(playMatches(*plusTeam, *minusTeam, iterationOptions, settings.m_matches, settings.m_threads)) - 1;
+		}
+
+		for (size_t i = 0; i < point.size(); ++i)
+			point[i] = std::max(0.0, std::min(1.0, point[i] + ak * difference / (2 * ck * delta[i])));
+
+		const Parameters current = makeParameters(base, settings, point);
+		if (!current.save(settings.m_outPath))
+		{
+			std::fprintf(stderr, "can't write %s\n", settings.m_outPath.c_str());
+			return 3;
+		}
+
+		std::printf("%4d: plus-minus %+.3f, a %.4f, c %.4f:", k + 1, difference, ak, ck);
+		printParameters(current, settings);
+		std::fflush(stdout);
+	}
+
+	std::printf("written to %s, check with: tournament --candidate mine:%s --baseline mine\n", settings.m_outPath.c_str(), settings.m_outPath.c_str());
+	return 0;
+}
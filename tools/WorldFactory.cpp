@@ -0,0 +1,189 @@
+#include "WorldFactory.h"
+#include "../Utils.h"
+#include <random>
+
+using namespace model;
+
+Game WorldFactory::makeGame(long long randomSeed)
+{
+	// CodeHockey rules values
+	const int tickCount = 6000;
+	const double worldWidth = 1200.0;
+	const double worldHeight = 800.0;
+	const double goalNetTop = 355.0;
+	const double goalNetWidth = 55.0;
+	const double goalNetHeight = 200.0;
+	const double rinkTop = 150.0;
+	const double rinkLeft = 65.0;
+	const double rinkBottom = 770.0;
+	const double rinkRight = 1135.0;
+	const int afterGoalStateTickCount = 200;
+	const int overtimeTickCount = 2000;
+	const int defaultActionCooldownTicks = 60;
+	const int swingActionCooldownTicks = 10;
+	const int cancelStrikeActionCooldownTicks = 60;
+	const int actionCooldownTicksAfterLosingPuck = 60;
+	const double stickLength = 120.0;
+	const double stickSector = PI / 6.0;
+	const double passSector = PI / 3.0;
+	const int hockeyistAttributeBaseValue = 100;
+	const double minActionChance = 0.05;
+	const double maxActionChance = 0.95;
+	const double strikeAngleDeviation = PI / 90.0;
+	const double passAngleDeviation = PI / 90.0;
+	const double pickUpPuckBaseChance = 0.6;
+	const double takePuckAwayBaseChance = 0.5;
+	const int maxEffectiveSwingTicks = 20;
+	const double strikePowerBaseFactor = 0.75;
+	const double strikePowerGrowthFactor = 0.0125;
+	const double strikePuckBaseChance = 0.75;
+	const double knockdownChanceFactor = 0.75;
+	const double knockdownTicksFactor = 60.0;
+	const double maxSpeedToAllowSubstitute = 1.0;
+	const double substitutionAreaHeight = 40.0;
+	const double passPowerFactor = 0.75;
+	const double hockeyistMaxStamina = 2000.0;
+	const double activeHockeyistStaminaGrowthPerTick = 0.5;
+	const double restingHockeyistStaminaGrowthPerTick = 1.0;
+	const double zeroStaminaHockeyistEffectivenessFactor = 0.75;
+	const double speedUpStaminaCostFactor = 1.0;
+	const double turnStaminaCostFactor = 1.0;
+	const double takePuckStaminaCost = 10.0;
+	const double swingStaminaCost = 10.0;
+	const double strikeStaminaBaseCost = 20.0;
+	const double strikeStaminaCostGrowthFactor = 0.5;
+	const double cancelStrikeStaminaCost = 5.0;
+	const double passStaminaCost = 20.0;
+	const double goalieMaxSpeed = 6.0;
+	const double hockeyistMaxSpeed = 15.0;
+	const double struckHockeyistInitialSpeedFactor = 20.0;
+	const double hockeyistSpeedUpFactor = 0.116;
+	const double hockeyistSpeedDownFactor = 0.069;
+	const double hockeyistTurnAngleFactor = 0.0523;
+	const int versatileHockeyistStrength = 100;
+	const int versatileHockeyistEndurance = 100;
+	const int versatileHockeyistDexterity = 100;
+	const int versatileHockeyistAgility = 100;
+	const int forwardHockeyistStrength = 100;
+	const int forwardHockeyistEndurance = 80;
+	const int forwardHockeyistDexterity = 120;
+	const int forwardHockeyistAgility = 100;
+	const int defencemanHockeyistStrength = 120;
+	const int defencemanHockeyistEndurance = 100;
+	const int defencemanHockeyistDexterity = 80;
+	const int defencemanHockeyistAgility = 100;
+	const int minRandomHockeyistParameter = 80;
+	const int maxRandomHockeyistParameter = 120;
+	const double struckPuckInitialSpeedFactor = 20.0;
+	const double puckBindingRange = 55.0;
+
+	return Game(randomSeed, tickCount, worldWidth, worldHeight, goalNetTop, goalNetWidth, goalNetHeight, rinkTop, rinkLeft,
+		rinkBottom, rinkRight, afterGoalStateTickCount, overtimeTickCount, defaultActionCooldownTicks,
+		swingActionCooldownTicks, cancelStrikeActionCooldownTicks, actionCooldownTicksAfterLosingPuck, stickLength,
+		stickSector, passSector, hockeyistAttributeBaseValue, minActionChance, maxActionChance, strikeAngleDeviation,
+		passAngleDeviation, pickUpPuckBaseChance, takePuckAwayBaseChance, maxEffectiveSwingTicks, strikePowerBaseFactor,
+		strikePowerGrowthFactor, strikePuckBaseChance, knockdownChanceFactor, knockdownTicksFactor, maxSpeedToAllowSubstitute,
+		substitutionAreaHeight, passPowerFactor, hockeyistMaxStamina, activeHockeyistStaminaGrowthPerTick,
+		restingHockeyistStaminaGrowthPerTick, zeroStaminaHockeyistEffectivenessFactor, speedUpStaminaCostFactor,
+		turnStaminaCostFactor, takePuckStaminaCost, swingStaminaCost, strikeStaminaBaseCost, strikeStaminaCostGrowthFactor,
+		cancelStrikeStaminaCost, passStaminaCost, goalieMaxSpeed, hockeyistMaxSpeed, struckHockeyistInitialSpeedFactor,
+		hockeyistSpeedUpFactor, hockeyistSpeedDownFactor, hockeyistTurnAngleFactor, versatileHockeyistStrength,
+		versatileHockeyistEndurance, versatileHockeyistDexterity, versatileHockeyistAgility, forwardHockeyistStrength,
+		forwardHockeyistEndurance, forwardHockeyistDexterity, forwardHockeyistAgility, defencemanHockeyistStrength,
+		defencemanHockeyistEndurance, defencemanHockeyistDexterity, defencemanHockeyistAgility, minRandomHockeyistParameter,
+		maxRandomHockeyistParameter, struckPuckInitialSpeedFactor, puckBindingRange);
+}
+
+Players WorldFactory::makePlayers(const Game& game, bool isMeLeft, int myGoals, int opponentGoals)
+{
+	const double netTop    = game.getGoalNetTop();
+	const double netBottom = game.getGoalNetTop() + game.getGoalNetHeight();
+	const double leftFront = game.getRinkLeft();
+	const double rightFront = game.getRinkRight();
+	const double netWidth  = game.getGoalNetWidth();
+
+	const Player left  = Player(isMeLeft ? kMY_PLAYER_ID : kOPPONENT_PLAYER_ID, isMeLeft, isMeLeft ? "me" : "opponent", isMeLeft ? myGoals : opponentGoals, false,
+		netTop, leftFront - netWidth, netBottom, leftFront, leftFront, leftFront - netWidth, false, false);
+	const Player right = Player(isMeLeft ? kOPPONENT_PLAYER_ID : kMY_PLAYER_ID, !isMeLeft, isMeLeft ? "opponent" : "me", isMeLeft ? opponentGoals : myGoals, false,
+		netTop, rightFront, netBottom, rightFront + netWidth, rightFront, rightFront + netWidth, false, false);
+
+	Players players;
+	players.push_back(left);
+	players.push_back(right);
+	return players;
+}
+
+World WorldFactory::makeWorld(const Game& game, unsigned seed, int tick, int teamSize, bool hasGoalies, PuckOwner owner)
+{
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<double> xDistribution(game.getRinkLeft() + kHOCKEYIST_RADIUS, game.getRinkRight() - kHOCKEYIST_RADIUS);
+	std::uniform_real_distribution<double> yDistribution(game.getRinkTop() + kHOCKEYIST_RADIUS, game.getRinkBottom() - kHOCKEYIST_RADIUS);
+	std::uniform_real_distribution<double> speedDistribution(-5.0, 5.0);
+	std::uniform_real_distribution<double> angleDistribution(-PI, PI);
+	std::uniform_int_distribution<int>     attributeDistribution(game.getMinRandomHockeyistParameter(), game.getMaxRandomHockeyistParameter());
+	std::uniform_real_distribution<double> staminaDistribution(0, game.getHockeyistMaxStamina());
+
+	const bool isMeLeft = (seed & 1) == 0;
+	Players players = makePlayers(game, isMeLeft);
+	const double centerY = (game.getRinkTop() + game.getRinkBottom()) / 2;
+
+	Hockeyists hockeyists;
+	long long id = 1;
+	for (int team = 0; team < 2; ++team)
+	{
+		const bool      isMine   = team == 0;
+		const long long playerId = isMine ? kMY_PLAYER_ID : kOPPONENT_PLAYER_ID;
+
+		for (int index = 0; index < teamSize; ++index)
+		{
+			hockeyists.push_back(Hockeyist(id++, playerId, index, kHOCKEYIST_MASS, kHOCKEYIST_RADIUS,
+				xDistribution(random), yDistribution(random), speedDistribution(random), speedDistribution(random), angleDistribution(random), 0,
+				isMine, RANDOM, attributeDistribution(random), attributeDistribution(random), attributeDistribution(random), attributeDistribution(random),
+				staminaDistribution(random), ACTIVE, index, 0, 0, 0, NONE, -1));
+		}
+
+		if (hasGoalies)
+		{
+			const bool   isLeftNet = isMine == isMeLeft;
+			const double goalieX   = isLeftNet ? game.getRinkLeft() + kHOCKEYIST_RADIUS : game.getRinkRight() - kHOCKEYIST_RADIUS;
+			hockeyists.push_back(Hockeyist(id++, playerId, teamSize, kHOCKEYIST_MASS, kHOCKEYIST_RADIUS, goalieX, centerY, 0, 0, isLeftNet ? 0 : PI, 0,
+				isMine, GOALIE, 100, 100, 100, 100, game.getHockeyistMaxStamina(), ACTIVE, teamSize, 0, 0, 0, NONE, -1));
+		}
+	}
+
+	// puck is free somewhere or at the stick of random field hockeyist of its owner
+	double puckX = xDistribution(random);
+	double puckY = yDistribution(random);
+	long long ownerHockeyistId = -1;
+	long long ownerPlayerId    = -1;
+	if (owner != eFREE)
+	{
+		const int        team  = owner == eMINE ? 0 : 1;
+		const int        index = std::uniform_int_distribution<int>(0, teamSize - 1)(random);
+		const Hockeyist& h     = hockeyists[team * (teamSize + (hasGoalies ? 1 : 0)) + index];
+
+		ownerHockeyistId = h.getId();
+		ownerPlayerId    = h.getPlayerId();
+		puckX = h.getX() + std::cos(h.getAngle()) * game.getPuckBindingRange();
+		puckY = h.getY() + std::sin(h.getAngle()) * game.getPuckBindingRange();
+	}
+
+	const Puck puck = Puck(kPUCK_ID, kPUCK_MASS, kPUCK_RADIUS, puckX, puckY, speedDistribution(random), speedDistribution(random), ownerHockeyistId, ownerPlayerId);
+	return World(tick, game.getTickCount(), game.getWorldWidth(), game.getWorldHeight(), players, hockeyists, puck);
+}
+
+std::vector<World> WorldFactory::makeCorpus(const Game& game, int count, unsigned seed)
+{
+	static const int kTEAM_SIZES[] = {2, 3};
+
+	std::vector<World> corpus;
+	corpus.reserve(count);
+	for (int i = 0; i < count; ++i)
+	{
+		const int       teamSize = kTEAM_SIZES[i % 2];
+		const PuckOwner owner    = static_cast<PuckOwner>(i % 3);
+		corpus.push_back(makeWorld(game, seed + i, i, teamSize, (i / 6) % 4 != 0, owner));
+	}
+
+	return corpus;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#ifndef _WORLD_FACTORY_H_
+#define _WORLD_FACTORY_H_
+
+#include "../model/Game.h"
+#include "../model/World.h"
+#include <vector>
+
+//! Synthetic game and worlds with CodeHockey rules constants, for benchmarks and offline tools
+namespace WorldFactory
+{
+	enum PuckOwner
+	{
+		eFREE = 0,
+		eMINE,
+		eOPPONENT,
+	};
+
+	static const long long kMY_PLAYER_ID       = 1;
+	static const long long kOPPONENT_PLAYER_ID = 2;
+	static const long long kPUCK_ID            = 1000;
+
+	static const double    kHOCKEYIST_RADIUS   = 30.0;
+	static const double    kHOCKEYIST_MASS     = 85.0;
+	static const double    kPUCK_RADIUS        = 20.0;
+	static const double    kPUCK_MASS          = 0.1;
+
+	model::Game makeGame(long long randomSeed = 0);
+
+	//! players as seen by 'me': my net is on the left if isMeLeft
+	model::Players makePlayers(const model::Game& game, bool isMeLeft, int myGoals = 0, int opponentGoals = 0);
+
+	//! random positions and speeds; goalies (if any) stay at their nets
+	model::World makeWorld(const model::Game& game, unsigned seed, int tick, int teamSize, bool hasGoalies, PuckOwner owner);
+
+	//! set of worlds covering team sizes, goalie presence and puck ownership
+	std::vector<model::World> makeCorpus(const model::Game& game, int count, unsigned seed);
+}
+
+#endif